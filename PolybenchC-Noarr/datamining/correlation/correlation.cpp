@@ -35,7 +35,7 @@ void init_array(num_t &float_n, auto data) {
 }
 
 // computation kernel
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_correlation(num_t float_n, auto data, auto corr, auto mean, auto stddev) {
 	// data: k x j
 	// corr: i x j
@@ -51,27 +51,28 @@ void kernel_correlation(num_t float_n, auto data, auto corr, auto mean, auto std
 	auto ni = corr | get_length<'i'>();
 
 	#pragma scop
-	traverser(data, mean) | for_dims<'j'>([=](auto inner) {
-		mean[inner] = 0;
+	// the mean and the standard deviation of a column are computed in a single walk over the columns
+	traverser(data, mean, stddev) | fuse<'j'>(
+		[=](auto inner) {
+			mean[inner] = 0;
 
-		inner | [=](auto state) {
-			mean[state] += data[state];
-		};
-
-		mean[inner] /= float_n;
-	});
+			inner | [=](auto state) {
+				mean[state] += data[state];
+			};
 
-	traverser(data, mean, stddev) | for_dims<'j'>([=](auto inner) {
-		stddev[inner] = 0;
+			mean[inner] /= float_n;
+		},
+		[=](auto inner) {
+			stddev[inner] = 0;
 
-		inner | [=](auto state) {
-			stddev[state] += (data[state] - mean[state]) * (data[state] - mean[state]);
-		};
+			inner | [=](auto state) {
+				stddev[state] += (data[state] - mean[state]) * (data[state] - mean[state]);
+			};
 
-		stddev[inner] /= float_n;
-		stddev[inner] = std::sqrt(stddev[inner]);
-		stddev[inner] = stddev[inner] <= eps ? (num_t)1.0 : stddev[inner];
-	});
+			stddev[inner] /= float_n;
+			stddev[inner] = std::sqrt(stddev[inner]);
+			stddev[inner] = stddev[inner] <= eps ? (num_t)1.0 : stddev[inner];
+		});
 
 	traverser(data, mean, stddev) | [=](auto state) {
 		data[state] -= mean[state];
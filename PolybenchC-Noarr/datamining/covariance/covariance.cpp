@@ -34,7 +34,7 @@ void init_array(num_t &float_n, auto data) {
 }
 
 // computation kernel
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_covariance(num_t float_n, auto data, auto cov, auto mean) {
 	// data: k x j
 	// cov: i x j
@@ -9,6 +9,14 @@
 #define DEFINE_PROTO_STRUCT(name, ...) AUTO_FIELD(name, __VA_ARGS__); \
     static_assert(noarr::IsProtoStruct<decltype(name)>)
 
+// compiles the kernels for several instruction sets, the best one is selected at startup (see noarr::dispatch_isa)
+#ifdef NOARR_POLYBENCH_ISA_DISPATCH
+# include <noarr/structures/interop/dispatch_isa.hpp>
+# define KERNEL_ISA NOARR_TARGET_CLONES
+#else
+# define KERNEL_ISA
+#endif
+
 #if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
 # error "Please define one of MINI_DATASET, SMALL_DATASET, MEDIUM_DATASET, LARGE_DATASET, EXTRALARGE_DATASET"
 # define MINI_DATASET
@@ -19,6 +19,10 @@ struct tuning {
 	DEFINE_PROTO_STRUCT(c_layout, j_vec ^ i_vec);
 	DEFINE_PROTO_STRUCT(a_layout, k_vec ^ i_vec);
 	DEFINE_PROTO_STRUCT(b_layout, j_vec ^ k_vec);
+
+	// cache-oblivious order of the accumulation (the leaves are traversed in the order chosen from the layouts: i, k, j)
+	AUTO_FIELD(bisect, noarr::recursive_bisect<'i', 'j', 'k'>(32));
+	DEFINE_PROTO_STRUCT(leaf_order, noarr::auto_order());
 } tuning;
 
 // initialization function
@@ -48,23 +52,26 @@ void init_array(num_t &alpha, num_t &beta, auto C, auto A, auto B) {
 }
 
 // computation kernel
-[[gnu::flatten, gnu::noinline]]
-void kernel_gemm(num_t alpha, num_t beta, auto C, auto A, auto B) {
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
+void kernel_gemm(num_t alpha, num_t beta, auto C, auto A, auto B, auto bisect, auto leaf_order) {
 	// C: i x j
 	// A: i x k
 	// B: k x j
 	using namespace noarr;
 
 	#pragma scop
-	traverser(C, A, B) | for_dims<'i'>([=](auto inner) {
-		inner | for_each<'j'>([=](auto state) {
-			C[state] *= beta;
-		});
-
-		inner | [=](auto state) {
-			C[state] += alpha * A[state] * B[state];
-		};
+#ifdef NOARR_POLYBENCH_GEMM_ENGINE
+	(void)bisect, (void)leaf_order;
+	gemm(C, A, B, alpha, beta);
+#else
+	traverser(C) | [=](auto state) {
+		C[state] *= beta;
+	};
+
+	traverser(C, A, B) ^ leaf_order | bisect.for_each([=](auto state) {
+		C[state] += alpha * A[state] * B[state];
 	});
+#endif
 	#pragma endscop
 }
 
@@ -94,7 +101,7 @@ int main(int argc, char *argv[]) {
 	auto start = std::chrono::high_resolution_clock::now();
 
 	// run kernel
-	kernel_gemm(alpha, beta, C.get_ref(), A.get_ref(), B.get_ref());
+	kernel_gemm(alpha, beta, C.get_ref(), A.get_ref(), B.get_ref(), tuning.bisect, tuning.leaf_order);
 
 	auto end = std::chrono::high_resolution_clock::now();
 
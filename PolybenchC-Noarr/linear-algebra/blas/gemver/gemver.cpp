@@ -76,7 +76,7 @@ void init_array(num_t &alpha, num_t &beta, auto A, auto u1, auto v1, auto u2, au
 
 // computation kernel
 template<class Order1 = noarr::neutral_proto, class Order2 = noarr::neutral_proto, class Order3 = noarr::neutral_proto>
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_gemver(num_t alpha, num_t beta, auto A,
 	auto u1, auto v1,
 	auto u2, auto v2,
@@ -97,21 +97,13 @@ void kernel_gemver(num_t alpha, num_t beta, auto A,
 	auto x_j = x ^ rename<'i', 'j'>();
 
 	#pragma scop
-	traverser(A, u1, u2, v1, v2) ^ order1 | [=](auto state) {
-		A[state] = A[state] + u1[state] * v1[state] + u2[state] * v2[state];
-	};
+	expr(A) ^ order1 = expr(A) + expr(u1) * v1 + expr(u2) * v2;
 
-	traverser(x, A_ji, y) ^ order2 | [=](auto state) {
-		x[state] = x[state] + beta * A_ji[state] * y[state];
-	};
+	expr(x) ^ order2 = expr(x) + beta * expr(A_ji) * y;
 
-	traverser(x, z) | [=](auto state) {
-		x[state] = x[state] + z[state];
-	};
+	expr(x) = expr(x) + z;
 
-	traverser(A, w, x_j) ^ order3 | [=](auto state) {
-		w[state] = w[state] + alpha * A[state] * x_j[state];
-	};
+	expr(w) ^ order3 = expr(w) + alpha * expr(A) * x_j;
 	#pragma endscop
 }
 
@@ -46,7 +46,7 @@ void init_array(num_t &alpha, num_t &beta, auto A, auto B, auto x) {
 }
 
 // computation kernel
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_gesummv(num_t alpha, num_t beta, auto A, auto B, auto tmp, auto x, auto y) {
 	// A: i x j
 	// B: i x j
@@ -60,7 +60,7 @@ void init_array(num_t &alpha, num_t &beta, auto C, auto A, auto B) {
 
 // computation kernel
 template<class Order = noarr::neutral_proto>
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_symm(num_t alpha, num_t beta, auto C, auto A, auto B, Order order = {}) {
 	// C: i x j
 	// A: i x k
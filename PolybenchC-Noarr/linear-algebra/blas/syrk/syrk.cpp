@@ -49,7 +49,7 @@ void init_array(num_t &alpha, num_t &beta, auto C, auto A) {
 
 // computation kernel
 template<class Order = noarr::neutral_proto>
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_syrk(num_t alpha, num_t beta, auto C, auto A, Order order = {}) {
 	// C: i x j
 	// A: i x k
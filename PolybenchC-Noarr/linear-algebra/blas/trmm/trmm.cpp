@@ -55,7 +55,7 @@ void init_array(num_t &alpha, auto A, auto B) {
 
 // computation kernel
 template<class Order = noarr::neutral_proto>
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_trmm(num_t alpha, auto A, auto B, Order order = {}) {
 	// A: k x i
 	// B: i x j
@@ -72,7 +72,7 @@ void init_array(num_t &alpha, num_t &beta, auto A, auto B, auto C, auto D) {
 
 // computation kernel
 template<class Order1 = noarr::neutral_proto, class Order2 = noarr::neutral_proto>
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_2mm(num_t alpha, num_t beta, auto tmp, auto A, auto B, auto C, auto D, Order1 order1 = {}, Order2 order2 = {}) {
 	// tmp: i x j
 	// A: i x k
@@ -82,6 +82,11 @@ void kernel_2mm(num_t alpha, num_t beta, auto tmp, auto A, auto B, auto C, auto
 	using namespace noarr;
 
 	#pragma scop
+#ifdef NOARR_POLYBENCH_GEMM_ENGINE
+	(void)order1, (void)order2;
+	gemm(tmp, A, B, alpha, num_t(0));
+	gemm(D, tmp, C, num_t(1), beta);
+#else
 	planner(tmp, A, B) ^ for_each_elem([=](auto &&tmp, auto &&A, auto &&B) {
 		tmp += alpha * A * B;
 	}) ^ for_dims<'i', 'j'>([=](auto inner) {
@@ -95,6 +100,7 @@ void kernel_2mm(num_t alpha, num_t beta, auto tmp, auto A, auto B, auto C, auto
 		D[inner] *= beta;
 		inner();
 	}) ^ order2 | planner_execute();
+#endif
 	#pragma endscop
 }
 
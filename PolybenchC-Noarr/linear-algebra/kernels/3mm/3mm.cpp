@@ -74,7 +74,7 @@ void init_array(auto A, auto B, auto C, auto D) {
 
 // computation kernel
 template<class Order1 = noarr::neutral_proto, class Order2 = noarr::neutral_proto, class Order3 = noarr::neutral_proto>
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_3mm(auto E, auto A, auto B, auto F, auto C, auto D, auto G, Order1 order1 = {}, Order2 order2 = {}, Order3 order3 = {}) {
 	// E: i x j
 	// A: i x k
@@ -90,6 +90,12 @@ void kernel_3mm(auto E, auto A, auto B, auto F, auto C, auto D, auto G, Order1 o
 	});
 
 	#pragma scop
+#ifdef NOARR_POLYBENCH_GEMM_ENGINE
+	(void)madd, (void)order1, (void)order2, (void)order3;
+	gemm(E, A, B, num_t(1), num_t(0));
+	gemm(F, C, D, num_t(1), num_t(0));
+	gemm(G, E, F, num_t(1), num_t(0));
+#else
 	planner(E, A, B) ^ madd ^ for_dims<'i', 'j'>([=](auto inner) {
 		E[inner] = 0;
 		inner();
@@ -104,6 +110,7 @@ void kernel_3mm(auto E, auto A, auto B, auto F, auto C, auto D, auto G, Order1 o
 		G[inner] = 0;
 		inner();
 	}) ^ order3 | planner_execute();
+#endif
 	#pragma endscop
 }
 
@@ -39,7 +39,7 @@ void init_array(auto A, auto x) {
 }
 
 // computation kernel
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_atax(auto A, auto x, auto y, auto tmp) {
 	// A: i x j
 	// x: j
@@ -89,7 +89,8 @@ int main(int argc, char *argv[]) {
 	auto start = std::chrono::high_resolution_clock::now();
 
 	// run kernel
-	kernel_atax(A.get_ref(), x.get_ref(), y.get_ref(), tmp.get_ref());
+	auto [A_ref, x_ref, y_ref, tmp_ref] = noarr::noalias(A, x, y, tmp);
+	kernel_atax(A_ref, x_ref, y_ref, tmp_ref);
 
 	auto end = std::chrono::high_resolution_clock::now();
 
@@ -48,7 +48,7 @@ void init_array(auto A, auto r, auto p) {
 
 // computation kernel
 template<class Order = noarr::neutral_proto>
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_bicg(auto A, auto s, auto q, auto p, auto r, Order order = {}) {
 	// A: i x j
 	// s: j
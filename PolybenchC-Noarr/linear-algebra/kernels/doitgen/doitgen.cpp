@@ -1,4 +1,5 @@
 #include <chrono>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 
@@ -47,7 +48,7 @@ void init_array(auto A, auto C4) {
 
 // computation kernel
 template<class Order = noarr::neutral_proto>
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_doitgen(auto A, auto C4, auto sum, Order order = {}) {
 	// A: r x q x p
 	// C4: s x p
@@ -79,9 +80,9 @@ int main(int argc, char *argv[]) {
 	using namespace std::string_literals;
 
 	// problem size
-	std::size_t nr = NR;
-	std::size_t nq = NQ;
-	std::size_t np = NP;
+	std::uint32_t nr = NR;
+	std::uint32_t nq = NQ;
+	std::uint32_t np = NP;
 
 	auto set_lengths = noarr::set_length<'r'>(nr) ^ noarr::set_length<'q'>(nq) ^ noarr::set_length<'s'>(np) ^ noarr::set_length<'p'>(np);
 
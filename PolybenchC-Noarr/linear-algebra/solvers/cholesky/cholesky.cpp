@@ -63,7 +63,7 @@ void init_array(auto A) {
 }
 
 // computation kernel
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_cholesky(auto A) {
 	// A: i x j
 	using namespace noarr;
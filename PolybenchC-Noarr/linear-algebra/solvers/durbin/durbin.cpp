@@ -25,7 +25,7 @@ void init_array(auto r) {
 }
 
 // computation kernel
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_durbin(auto r, auto y) {
 	// r: i
 	// y: i
@@ -45,7 +45,7 @@ void init_array(auto A, auto R, auto Q) {
 }
 
 // computation kernel
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_gramschmidt(auto A, auto R, auto Q) {
 	// A: i x k
 	// R: k x j
@@ -63,7 +63,7 @@ void init_array(auto A) {
 
 // computation kernel
 template<typename Order = noarr::neutral_proto>
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_lu(auto A, Order order = {}) {
 	// A: i x j
 	using namespace noarr;
@@ -74,7 +74,7 @@ void init_array(auto A, auto b, auto x, auto y) {
 }
 
 // computation kernel
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_ludcmp(auto A, auto b, auto x, auto y) {
 	// A: i x j
 	// b: i
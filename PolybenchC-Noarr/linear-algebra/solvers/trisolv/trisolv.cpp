@@ -42,7 +42,7 @@ void init_array(auto L, auto x, auto b) {
 }
 
 // computation kernel
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_trisolv(auto L, auto x, auto b) {
 	// L: i x j
 	// x: i
@@ -57,9 +57,9 @@ void kernel_trisolv(auto L, auto x, auto b) {
 
 		x[inner] = b[inner];
 
-		inner ^ span<'j'>(i) | [=](auto state) {
-			x[state] -= L[state] * x_j[state];
-		};
+		inner ^ span<'j'>(i) | accumulate_into(x, [=](num_t &x_i, auto state) {
+			x_i -= L[state] * x_j[state];
+		});
 
 		x[inner] = x[inner] / L[inner.state() & idx<'j'>(i)];
 	});
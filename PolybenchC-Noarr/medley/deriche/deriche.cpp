@@ -38,7 +38,7 @@ void init_array(num_t &alpha, auto imgIn, auto) {
 }
 
 // computation kernel
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_deriche(num_t alpha, auto imgIn, auto imgOut, auto y1, auto y2) {
 	// imgIn: w x h
 	// imgOut: w x h
@@ -120,9 +120,16 @@ void kernel_deriche(num_t alpha, auto imgIn, auto imgOut, auto y1, auto y2) {
 		};
 	});
 
+#ifdef NOARR_POLYBENCH_STREAMING_STORES
+	// imgOut is not read again by the kernel
+	traverser(y1, y2, imgOut) | stream_into(imgOut, [=](auto state) {
+		return c2 * (y1[state] + y2[state]);
+	});
+#else
 	traverser(y1, y2, imgOut) | [=](auto state) {
 		imgOut[state] = c2 * (y1[state] + y2[state]);
 	};
+#endif
 	#pragma endscop
 }
 
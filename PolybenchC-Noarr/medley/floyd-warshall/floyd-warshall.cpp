@@ -44,7 +44,7 @@ void init_array(auto path) {
 
 // computation kernel
 template<class Order = noarr::neutral_proto>
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_floyd_warshall(auto path, Order order = {}) {
 	// path: i x j
 	using namespace noarr;
@@ -40,7 +40,7 @@ void init_array(auto seq, auto table) {
 }
 
 // computation kernel
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_nussinov(auto seq, auto table) {
 	// seq: i
 	// table: i x j
@@ -53,32 +53,28 @@ void kernel_nussinov(auto seq, auto table) {
 	#pragma scop
 	traverser(seq, table, table_ik, table_kj) ^ reverse<'i'>() | for_dims<'i'>([=](auto inner) {
 		auto i = get_index<'i'>(inner);
-		inner ^ shift<'j'>(i + 1) | for_dims<'j'>([=](auto inner) {
+		// the first `j` (`j == i + 1`) is peeled off, the guards `j >= 0` and `i + 1 < ni` always hold in the loop
+		inner ^ shift<'j'>(i + 1) | peel<'j'>(1, 0).for_dims<'j'>([=](auto inner, auto region) {
 			auto state = inner.state();
 			auto [i, j] = get_indices<'i', 'j'>(state);
-			auto ni = table | get_length<'i'>();
 
-			if (j >= 0)
+			table[state] = max_score(
+				table[state],
+				table[state - idx<'j'>(1)]);
+
+			table[state] = max_score(
+				table[state],
+				table[state + idx<'i'>(1)]);
+
+			if constexpr (region == peel_region::body)
 				table[state] = max_score(
 					table[state],
-					table[state - idx<'j'>(1)]);
-
-			if (i + 1 < ni)
+					table[state + idx<'i'>(1) - idx<'j'>(1)] +
+					match(seq[state], seq_j[state]));
+			else
 				table[state] = max_score(
 					table[state],
-					table[state + idx<'i'>(1)]);
-
-			if (j >= 0 || i + 1 < ni) {
-				if (i < j - 1)
-					table[state] = max_score(
-						table[state],
-						table[state + idx<'i'>(1) - idx<'j'>(1)] +
-						match(seq[state], seq_j[state]));
-				else
-					table[state] = max_score(
-						table[state],
-						table[state + idx<'i'>(1) - idx<'j'>(1)]);
-			}
+					table[state + idx<'i'>(1) - idx<'j'>(1)]);
 
 			inner ^ span<'k'>(i + 1, j) | [=](auto state) {
 				table[state] = max_score(
@@ -36,7 +36,7 @@ void init_array(auto u) {
 }
 
 // computation kernel
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_adi(auto tsteps, auto u, auto v, auto p, auto q) {
 	// u: i x j
 	// v: j x i
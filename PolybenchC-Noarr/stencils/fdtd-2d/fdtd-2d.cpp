@@ -47,7 +47,7 @@ void init_array(auto ex, auto ey, auto hz, auto _fict_) {
 
 
 // computation kernel
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_fdtd_2d(auto ex, auto ey, auto hz, auto _fict_) {
 	// ex: i x j
 	// ey: i x j
@@ -16,11 +16,8 @@ constexpr auto j_vec = noarr::vector<'j'>();
 constexpr auto k_vec = noarr::vector<'k'>();
 
 struct tuning {
-	DEFINE_PROTO_STRUCT(block_i, noarr::hoist<'i'>());
-	DEFINE_PROTO_STRUCT(block_j, noarr::hoist<'j'>());
-	DEFINE_PROTO_STRUCT(block_k, noarr::hoist<'k'>());
-
-	DEFINE_PROTO_STRUCT(order, block_k ^ block_j ^ block_i);
+	// 2.5D blocking: tiles of 'j' x 'k', streamed along 'i' (the outermost dimension of the layouts)
+	DEFINE_PROTO_STRUCT(order, noarr::blocking_2_5d<'j', 'k', 'i'>(16, 128));
 
 	DEFINE_PROTO_STRUCT(a_layout, k_vec ^ j_vec ^ i_vec);
 	DEFINE_PROTO_STRUCT(b_layout, k_vec ^ j_vec ^ i_vec);
@@ -42,7 +39,7 @@ void init_array(auto A, auto B) {
 
 // computation kernel
 template<class Order = noarr::neutral_proto>
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_heat_3d(std::size_t tsteps, auto A, auto B, Order order = {}) {
 	// A: i x j x k
 	// B: i x j x k
@@ -50,34 +47,26 @@ void kernel_heat_3d(std::size_t tsteps, auto A, auto B, Order order = {}) {
 
 	auto trav = traverser(A, B) ^ bcast<'t'>(tsteps);
 
+	constexpr auto seven_point = stencil<'i', 'j', 'k'>({{0, 0, 0}, {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}});
+	const auto A_stencil = seven_point.bind(A);
+	const auto B_stencil = seven_point.bind(B);
+
+	const auto heat = [](num_t c, num_t im, num_t ip, num_t jm, num_t jp, num_t km, num_t kp) {
+		return
+			(num_t).125 * (im - 2 * c + ip) +
+			(num_t).125 * (jm - 2 * c + jp) +
+			(num_t).125 * (km - 2 * c + kp) +
+			c;
+	};
+
 	#pragma scop
 	trav ^ symmetric_spans<'i', 'j', 'k'>(A, 1, 1, 1) ^ order | for_dims<'t'>([=](auto inner) {
 		inner | [=](auto state) {
-			B[state] =
-				(num_t).125 * (A[state - idx<'i'>(1)] -
-				               2 * A[state] +
-				               A[state + idx<'i'>(1)]) +
-				(num_t).125 * (A[state - idx<'j'>(1)] -
-				               2 * A[state] +
-				               A[state + idx<'j'>(1)]) +
-				(num_t).125 * (A[state - idx<'k'>(1)] -
-				               2 * A[state] +
-				               A[state + idx<'k'>(1)]) +
-				A[state];
+			B[state] = A_stencil.combine(state, heat);
 		};
 
 		inner | [=](auto state) {
-			A[state] =
-				(num_t).125 * (B[state - idx<'i'>(1)] -
-				               2 * B[state] +
-				               B[state + idx<'i'>(1)]) +
-				(num_t).125 * (B[state - idx<'j'>(1)] -
-				               2 * B[state] +
-				               B[state + idx<'j'>(1)]) +
-				(num_t).125 * (B[state - idx<'k'>(1)] -
-				               2 * B[state] +
-				               B[state + idx<'k'>(1)]) +
-				B[state];
+			A[state] = B_stencil.combine(state, heat);
 		};
 	});
 	#pragma endscop
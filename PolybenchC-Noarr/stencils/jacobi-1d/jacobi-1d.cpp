@@ -11,6 +11,11 @@ using num_t = DATA_TYPE;
 
 namespace {
 
+struct tuning {
+	// parallelogram tiles over the half steps ('t') and the interior ('i'), see the kernel
+	DEFINE_PROTO_STRUCT(tiles, noarr::time_tiles<'t', 'i', 'T', 'I'>(32, 2048));
+} tuning;
+
 // initialization function
 void init_array(auto A, auto B) {
 	// A: i
@@ -29,23 +34,28 @@ void init_array(auto A, auto B) {
 
 
 // computation kernel
-[[gnu::flatten, gnu::noinline]]
-void kernel_jacobi_1d(std::size_t tsteps, auto A, auto B) {
+template<class Tiles>
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
+void kernel_jacobi_1d(std::size_t tsteps, auto A, auto B, Tiles tiles) {
 	// A: i
 	// B: i
 	using namespace noarr;
 
-	auto trav = traverser(A, B) ^ bcast<'t'>(tsteps);
+	// each time step consists of two half steps (B from A and A from B), each depending only on the distance 1 in 'i'
+	auto steps = scalar<char>() ^ bcast<'t'>(2 * tsteps);
+	auto trav = traverser(A, B, steps) ^ symmetric_span<'i'>(A, 1) ^ tiles;
 
 	#pragma scop
-	trav | for_dims<'t'>([=](auto inner) {
-		inner ^ symmetric_span<'i'>(B, 1) | [=](auto state) {
-			B[state] = 0.33333 * (A[state - idx<'i'>(1)] + A[state] + A[state + idx<'i'>(1)]);
-		};
-
-		inner ^ symmetric_span<'i'>(A, 1) | [=](auto state) {
-			A[state] = 0.33333 * (B[state - idx<'i'>(1)] + B[state] + B[state + idx<'i'>(1)]);
-		};
+	trav | for_dims<'T', 'I', 't'>([=](auto inner) {
+		// the global half step (not the one within the tile), so the parity holds for any size of the tiles
+		if (get_index<'t'>(inner) % 2 == 0)
+			inner | [=](auto state) {
+				B[state] = 0.33333 * (A[state - idx<'i'>(1)] + A[state] + A[state + idx<'i'>(1)]);
+			};
+		else
+			inner | [=](auto state) {
+				A[state] = 0.33333 * (B[state - idx<'i'>(1)] + B[state] + B[state + idx<'i'>(1)]);
+			};
 	});
 	#pragma endscop
 }
@@ -69,7 +79,7 @@ int main(int argc, char *argv[]) {
 	auto start = std::chrono::high_resolution_clock::now();
 
 	// run kernel
-	kernel_jacobi_1d(t, A.get_ref(), B.get_ref());
+	kernel_jacobi_1d(t, A.get_ref(), B.get_ref(), tuning.tiles);
 
 	auto end = std::chrono::high_resolution_clock::now();
 
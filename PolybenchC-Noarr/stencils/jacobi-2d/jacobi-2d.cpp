@@ -44,7 +44,7 @@ void init_array(auto A, auto B) {
 
 // computation kernel
 template<class Order = noarr::neutral_proto>
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_jacobi_2d(std::size_t tsteps, auto A, auto B, Order order = {}) {
 	// A: i x j
 	// B: i x j
@@ -52,24 +52,18 @@ void kernel_jacobi_2d(std::size_t tsteps, auto A, auto B, Order order = {}) {
 
 	auto trav = traverser(A, B) ^ bcast<'t'>(tsteps);
 
+	constexpr auto five_point = stencil<'i', 'j'>({{0, 0}, {0, -1}, {0, 1}, {1, 0}, {-1, 0}});
+	const auto A_stencil = five_point.bind(A);
+	const auto B_stencil = five_point.bind(B);
+
 	#pragma scop
 	trav ^ symmetric_spans<'i', 'j'>(A, 1, 1) ^ order | for_dims<'t'>([=](auto inner) {
 		inner | [=](auto state) {
-			B[state] = (num_t).2 * (
-				A[state] +
-				A[state - idx<'j'>(1)] +
-				A[state + idx<'j'>(1)] +
-				A[state + idx<'i'>(1)] +
-				A[state - idx<'i'>(1)]);
+			B[state] = (num_t).2 * A_stencil.sum(state);
 		};
 
 		inner | [=](auto state) {
-			A[state] = (num_t).2 * (
-				B[state] +
-				B[state - idx<'j'>(1)] +
-				B[state + idx<'j'>(1)] +
-				B[state + idx<'i'>(1)] +
-				B[state - idx<'i'>(1)]);
+			A[state] = (num_t).2 * B_stencil.sum(state);
 		};
 	});
 	#pragma endscop
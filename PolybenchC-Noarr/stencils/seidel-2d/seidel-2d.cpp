@@ -33,7 +33,7 @@ void init_array(auto A) {
 }
 
 // computation kernel
-[[gnu::flatten, gnu::noinline]]
+[[gnu::flatten, gnu::noinline, KERNEL_ISA]]
 void kernel_seidel_2d(std::size_t tsteps, auto A) {
 	// A: i x j
 	using namespace noarr;
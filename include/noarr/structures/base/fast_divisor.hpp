@@ -0,0 +1,113 @@
+#ifndef NOARR_STRUCTURES_FAST_DIVISOR_HPP
+#define NOARR_STRUCTURES_FAST_DIVISOR_HPP
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#include "../base/utility.hpp"
+
+namespace noarr {
+
+namespace helpers {
+
+#if defined(__SIZEOF_INT128__) && __SIZE_WIDTH__ == 64
+__extension__ using fast_divisor_wide_t = unsigned __int128;
+#define NOARR_FAST_DIVISOR_MAGIC
+#endif
+
+} // namespace helpers
+
+/**
+ * @brief a runtime divisor with a precomputed magic multiplier (the round-up method of Granlund and Montgomery, as in libdivide),
+ * so that the division (and the remainder) is a multiplication and shifts instead of a `div` instruction; division by a power of two is just a shift
+ *
+ * The multiplier is computed when the divisor is constructed (which is itself a division), so it pays off
+ * when the divisor is constructed once and kept (e.g. by `merge_blocks_t`) or outside the loop dividing by it.
+ * A zero divisor can be constructed (e.g. for an empty dimension), but not divided by.
+ */
+struct fast_divisor {
+	std::size_t divisor;
+	std::size_t multiplier = 0; // zero for powers of two
+	unsigned shift = 0;
+	bool add = false; // whether the multiplier needs an extra (65th) bit
+
+	constexpr explicit fast_divisor(std::size_t divisor) noexcept : divisor(divisor) {
+#ifdef NOARR_FAST_DIVISOR_MAGIC
+		if (divisor == 0)
+			return;
+
+		// the division is done unconditionally (even for powers of two), so that the compiler can hoist it out of loops
+		const unsigned floor_log2 = unsigned(std::bit_width(divisor) - 1);
+		const auto wide = helpers::fast_divisor_wide_t(1) << (64 + floor_log2);
+		auto proposed = std::size_t(wide / divisor);
+		const auto rem = std::size_t(wide - helpers::fast_divisor_wide_t(proposed) * divisor);
+		shift = floor_log2;
+		if ((divisor & (divisor - 1)) == 0)
+			return;
+
+		if (divisor - rem >= (std::size_t(1) << floor_log2)) {
+			// the multiplier does not fit: use the 65-bit one (`2 * proposed + 1`, the top bit is handled by `add`)
+			const std::size_t twice_rem = rem + rem;
+			proposed += proposed;
+			if (twice_rem >= divisor || twice_rem < rem)
+				proposed += 1;
+			add = true;
+		}
+		multiplier = proposed + 1;
+#endif
+	}
+
+	constexpr std::size_t divide(std::size_t n) const noexcept {
+		assert(divisor != 0 && "Division by zero");
+#ifdef NOARR_FAST_DIVISOR_MAGIC
+		if (multiplier == 0)
+			return n >> shift;
+		const auto high = std::size_t((helpers::fast_divisor_wide_t(multiplier) * n) >> 64);
+		if (add)
+			return (((n - high) >> 1) + high) >> shift;
+		return high >> shift;
+#else
+		return n / divisor;
+#endif
+	}
+
+	constexpr std::size_t modulo(std::size_t n) const noexcept {
+		return n - divide(n) * divisor;
+	}
+};
+
+/**
+ * @brief divides `index` by `length`, returns the quotient and the remainder (as a pair);
+ * a static `length` (`lit<N>`) is left to the compiler, a dynamic one goes through `fast_divisor`
+ * (constructed for each call; a divisor used repeatedly should rather be kept, see `div_mod` below)
+ */
+template<class Index, class Length>
+constexpr auto div_mod(Index index, Length length) noexcept {
+	using namespace constexpr_arithmetic;
+	if constexpr (std::is_empty_v<Length> || std::is_empty_v<Index>) {
+		return std::make_pair(index / length, index % length);
+	} else {
+		const fast_divisor divisor(length);
+		const std::size_t quotient = divisor.divide(index);
+		return std::make_pair(quotient, std::size_t(index) - quotient * divisor.divisor);
+	}
+}
+
+/**
+ * @brief divides `index` by the precomputed `divisor`, returns the quotient and the remainder (as a pair)
+ */
+template<class Index>
+constexpr auto div_mod(Index index, const fast_divisor &divisor) noexcept {
+	if constexpr (std::is_empty_v<Index>) {
+		return div_mod(index, divisor.divisor);
+	} else {
+		const std::size_t quotient = divisor.divide(index);
+		return std::make_pair(quotient, std::size_t(index) - quotient * divisor.divisor);
+	}
+}
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_FAST_DIVISOR_HPP
@@ -2,6 +2,7 @@
 #define NOARR_STRUCTURES_SIGNATURE_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <tuple>
 #include <type_traits>
 
@@ -33,6 +34,8 @@ template<class T>
 struct arg_length_from;
 template<>
 struct arg_length_from<std::size_t> { using type = dynamic_arg_length; };
+template<class T> requires (std::is_same_v<T, std::uint32_t> && !std::is_same_v<T, std::size_t>)
+struct arg_length_from<T> { using type = dynamic_arg_length; };
 template<std::size_t L>
 struct arg_length_from<std::integral_constant<std::size_t, L>> { using type = static_arg_length<L>; };
 
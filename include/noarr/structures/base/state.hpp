@@ -2,6 +2,7 @@
 #define NOARR_STRUCTURES_STATE_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <concepts>
 #include <type_traits>
 
@@ -258,6 +259,10 @@ namespace helpers {
 
 constexpr std::size_t supported_index_type(std::size_t);
 
+// 32-bit indices are kept as they are (only an exact match, so that other integers still convert to `std::size_t`)
+template<class T> requires std::same_as<T, std::uint32_t>
+constexpr std::uint32_t supported_index_type(T);
+
 template<std::size_t Value>
 constexpr std::integral_constant<std::size_t, Value> supported_index_type(std::integral_constant<std::size_t, Value>);
 
@@ -272,6 +277,9 @@ constexpr std::integral_constant<std::ptrdiff_t, Value> supported_diff_type(std:
 constexpr std::size_t supported_diff_index_type(std::size_t);
 constexpr std::size_t supported_diff_index_type(std::ptrdiff_t);
 
+template<class T> requires std::same_as<T, std::uint32_t>
+constexpr std::uint32_t supported_diff_index_type(T);
+
 template<std::size_t Value>
 constexpr std::integral_constant<std::size_t, Value> supported_diff_index_type(std::integral_constant<std::size_t, Value>);
 template<std::ptrdiff_t Value>
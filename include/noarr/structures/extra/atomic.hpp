@@ -0,0 +1,123 @@
+#ifndef NOARR_STRUCTURES_ATOMIC_HPP
+#define NOARR_STRUCTURES_ATOMIC_HPP
+
+#include <atomic>
+#include <type_traits>
+
+#include "../base/contain.hpp"
+#include "../base/state.hpp"
+#include "../extra/to_struct.hpp"
+#include "../interop/bag.hpp"
+
+namespace noarr {
+
+namespace helpers {
+
+// the memory order of a load (a load cannot release)
+constexpr std::memory_order atomic_load_order(std::memory_order order) noexcept {
+	switch (order) {
+	case std::memory_order_release: return std::memory_order_relaxed;
+	case std::memory_order_acq_rel: return std::memory_order_acquire;
+	default: return order;
+	}
+}
+
+// the memory order of a store (a store cannot acquire)
+constexpr std::memory_order atomic_store_order(std::memory_order order) noexcept {
+	switch (order) {
+	case std::memory_order_acquire: return std::memory_order_relaxed;
+	case std::memory_order_consume: return std::memory_order_relaxed;
+	case std::memory_order_acq_rel: return std::memory_order_release;
+	default: return order;
+	}
+}
+
+} // namespace helpers
+
+/**
+ * @brief a reference to an element of an `atomic` bag, all the operations are atomic (using `std::atomic_ref`) with the memory order `order`
+ * (restricted to its acquire part for loads and to its release part for stores, e.g. `acq_rel` loads are `acquire`)
+ */
+template<class T>
+struct atomic_elem_ref_t {
+	T *ptr;
+	std::memory_order order;
+
+	std::atomic_ref<T> ref() const noexcept { return std::atomic_ref<T>(*ptr); }
+
+	T load() const noexcept { return ref().load(helpers::atomic_load_order(order)); }
+	operator T() const noexcept { return load(); }
+
+	void store(T value) const noexcept { ref().store(value, helpers::atomic_store_order(order)); }
+	const atomic_elem_ref_t &operator=(T value) const noexcept { store(value); return *this; }
+
+	T exchange(T value) const noexcept { return ref().exchange(value, order); }
+
+	// `fetch_add` and `fetch_sub` return the previous value, `+=` and `-=` the new one (as `std::atomic_ref`)
+	T fetch_add(T value) const noexcept { return ref().fetch_add(value, order); }
+	T fetch_sub(T value) const noexcept { return ref().fetch_sub(value, order); }
+	T operator+=(T value) const noexcept { return fetch_add(value) + value; }
+	T operator-=(T value) const noexcept { return fetch_sub(value) - value; }
+
+	/**
+	 * @brief atomically replaces the value by `value` if `value` is lower, returns the previous value
+	 */
+	T fetch_min(T value) const noexcept { return update_if(value, [](T value, T old) { return value < old; }); }
+
+	/**
+	 * @brief atomically replaces the value by `value` if `value` is greater, returns the previous value
+	 */
+	T fetch_max(T value) const noexcept { return update_if(value, [](T value, T old) { return old < value; }); }
+
+private:
+	// a compare-and-swap loop; no store is performed if the value is not replaced
+	template<class Pred>
+	T update_if(T value, Pred pred) const noexcept {
+		const auto atomic = ref();
+		T old = atomic.load(std::memory_order_relaxed);
+		while (pred(value, old) && !atomic.compare_exchange_weak(old, value, order, std::memory_order_relaxed))
+			;
+		return old;
+	}
+};
+
+/**
+ * @brief a view of a bag whose elements are accessed atomically (see `atomic_elem_ref_t`), e.g. for scatters into a shared output
+ * from several threads (`out[idx<'v'>(in[state])] += 1` in `tbb_for_each` or `omp_for_each`), without per-thread copies
+ */
+template<class Bag>
+struct atomic_bag_t : strict_contain<Bag> {
+	using base = strict_contain<Bag>;
+	std::memory_order order;
+
+	constexpr atomic_bag_t(const Bag &bag, std::memory_order order) noexcept : base(bag), order(order) {}
+
+	constexpr Bag bag() const noexcept { return this->get(); }
+	constexpr auto structure() const noexcept { return bag().structure(); }
+	constexpr auto data() const noexcept { return bag().data(); }
+
+	constexpr auto operator[](ToState auto state) const noexcept {
+		using type = std::remove_reference_t<decltype(bag()[state])>;
+		static_assert(!std::is_const_v<type>, "Cannot access a read-only bag atomically");
+		static_assert(std::atomic_ref<type>::required_alignment <= alignof(type), "The elements of the bag are not aligned for atomic access");
+		return atomic_elem_ref_t<type>{&bag()[state], order};
+	}
+};
+
+/**
+ * @brief returns a view of the bag whose elements are accessed atomically with the memory order `order` (see `atomic_bag_t`)
+ */
+template<class Bag> requires IsBag<Bag>
+constexpr auto atomic(const Bag &bag, std::memory_order order = std::memory_order_relaxed) noexcept {
+	return atomic_bag_t<decltype(bag.get_ref())>(bag.get_ref(), order);
+}
+
+template<class Bag>
+struct to_struct<atomic_bag_t<Bag>> {
+	using type = typename to_struct<Bag>::type;
+	static constexpr type convert(const atomic_bag_t<Bag> &b) noexcept { return to_struct<Bag>::convert(b.bag()); }
+};
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_ATOMIC_HPP
@@ -0,0 +1,163 @@
+#ifndef NOARR_STRUCTURES_AUTO_ORDER_HPP
+#define NOARR_STRUCTURES_AUTO_ORDER_HPP
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../base/signature.hpp"
+#include "../base/structs_common.hpp"
+#include "../base/utility.hpp"
+#include "../structs/views.hpp"
+#include "../extra/to_struct.hpp"
+#include "../extra/traverser.hpp"
+
+namespace noarr {
+
+namespace helpers {
+
+// the (independent) dimensions of a signature, from the outermost to the innermost; stops at a tuple
+template<class Sig>
+struct auto_order_sig_dims {
+	using type = dim_sequence<>;
+};
+
+template<auto Dim, class ArgLength, class RetSig>
+struct auto_order_sig_dims<function_sig<Dim, ArgLength, RetSig>> {
+	using type = typename dim_sequence_concat_impl<dim_sequence<Dim>, typename auto_order_sig_dims<RetSig>::type>::type;
+};
+
+// the dimensions of a sequence without the `Removed` ones
+template<class Seq, auto ...Removed>
+struct auto_order_remove;
+
+template<auto ...Dims, auto ...Removed>
+struct auto_order_remove<dim_sequence<Dims...>, Removed...> {
+	using type = typename dim_sequence_concat_impl<dim_sequence<>,
+		std::conditional_t<dim_sequence<Removed...>::template contains<Dims>, dim_sequence<>, dim_sequence<Dims>>...>::type;
+};
+
+// the depth of the dimension `Dim` in a signature counted from the innermost dimension (0 for the innermost one), or 0 if it is not present
+template<auto Dim, class Sig>
+struct auto_order_depth {
+	static constexpr std::size_t value = 0;
+	static constexpr std::size_t below = 0;
+};
+
+template<auto Dim, auto SigDim, class ArgLength, class RetSig>
+struct auto_order_depth<Dim, function_sig<SigDim, ArgLength, RetSig>> {
+	static constexpr std::size_t below = auto_order_depth<Dim, RetSig>::below + 1;
+	static constexpr std::size_t value = SigDim == Dim ? below - 1 : auto_order_depth<Dim, RetSig>::value;
+};
+
+// the structures whose layouts are considered: the members of a union (of a traverser), or the structure itself
+template<class Struct>
+struct auto_order_structs {
+	template<auto Dim>
+	static constexpr std::size_t cost = auto_order_depth<Dim, typename Struct::signature>::value;
+};
+
+template<class ...Structs>
+struct auto_order_structs<union_t<Structs...>> {
+	template<auto Dim>
+	static constexpr std::size_t cost = (0 + ... + auto_order_depth<Dim, typename to_struct<Structs>::type::signature>::value);
+};
+
+template<class Struct, class Dims>
+struct auto_order_impl;
+
+template<class Struct, auto ...Dims>
+struct auto_order_impl<Struct, dim_sequence<Dims...>> {
+	// the indices of the dimensions sorted by the decreasing cost (stable, so the original order breaks ties)
+	static constexpr auto permutation = [] {
+		constexpr std::size_t n = sizeof...(Dims);
+		std::array<std::size_t, n> costs = {auto_order_structs<Struct>::template cost<Dims>...};
+		std::array<std::size_t, n> perm{};
+		for (std::size_t i = 0; i < n; i++)
+			perm[i] = i;
+		for (std::size_t i = 1; i < n; i++)
+			for (std::size_t j = i; j > 0 && costs[perm[j - 1]] < costs[perm[j]]; j--)
+				std::swap(perm[j - 1], perm[j]);
+		return perm;
+	}();
+
+	template<std::size_t I>
+	static constexpr auto dim = std::get<permutation[I]>(std::tuple(Dims...));
+
+	static constexpr auto hoists() noexcept {
+		return [] <std::size_t ...I> (std::index_sequence<I...>) {
+			if constexpr (sizeof...(I) == 0)
+				return neutral_proto();
+			else
+				return hoist<dim<I>...>();
+		}(std::make_index_sequence<sizeof...(Dims)>());
+	}
+};
+
+template<auto Dim>
+inline void auto_order_print_dim(std::ostream &out) {
+	if constexpr (std::is_same_v<decltype(Dim), char>)
+		out << '\'' << Dim << '\'';
+	else
+		out << "<dim>";
+}
+
+} // namespace helpers
+
+/**
+ * @brief a traversal order chosen at compile time from the layouts of the structures (bags) in the traversal:
+ * the dimensions are ordered by the decreasing sum of their nesting depths in the structures (0 for the innermost dimension
+ * of a structure; a structure without the dimension reuses its elements and adds nothing), ties keep the original order
+ *
+ * The depth is a proxy for the stride (the strides are generally runtime values). For a single structure made of vectors,
+ * it ranks the dimensions as their strides do, but the sums over several structures need not: e.g. a dimension at depth 1
+ * in two `n` x `n` matrices ties with a dimension at depth 2 in one `n` x `n` x `n` array, although their strides sum
+ * to `2 * n` and `n * n` elements. Such orders can be fixed by `Pinned` or by an explicit `hoist`.
+ *
+ * @tparam Pinned: dimensions kept outermost, in the given order (e.g. those traversed by `for_dims`)
+ */
+template<auto ...Pinned> requires IsDimPack<decltype(Pinned)...>
+struct auto_order_proto {
+	static constexpr bool proto_preserves_layout = true;
+
+	template<class Struct>
+	constexpr auto instantiate_and_construct(Struct s) const noexcept {
+		using free_dims = typename helpers::auto_order_remove<typename helpers::auto_order_sig_dims<typename Struct::signature>::type, Pinned...>::type;
+		const auto sorted = s ^ helpers::auto_order_impl<Struct, free_dims>::hoists();
+		if constexpr (sizeof...(Pinned) == 0)
+			return sorted;
+		else
+			return sorted ^ hoist<Pinned...>();
+	}
+};
+
+/**
+ * @brief chooses the order of the traversal automatically (see `auto_order_proto`)
+ */
+template<auto ...Pinned> requires IsDimPack<decltype(Pinned)...>
+constexpr auto auto_order() noexcept { return auto_order_proto<Pinned...>(); }
+
+/**
+ * @brief the dimensions of a traversal in the order they are traversed (from the outermost), as a `dim_sequence`
+ */
+template<IsTraverser T>
+using traversal_dims = typename helpers::auto_order_sig_dims<typename decltype(std::declval<T>().top_struct())::signature>::type;
+
+/**
+ * @brief prints the dimensions of a traversal in the order they are traversed (from the outermost), e.g. for inspecting `auto_order`
+ */
+template<IsTraverser T>
+inline std::ostream &print_order(std::ostream &out, const T &) {
+	[&out] <auto ...Dims> (dim_sequence<Dims...>) {
+		const char *sep = "";
+		(..., (out << sep, helpers::auto_order_print_dim<Dims>(out), sep = ", "));
+	}(traversal_dims<T>());
+	return out;
+}
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_AUTO_ORDER_HPP
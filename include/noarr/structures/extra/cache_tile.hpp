@@ -0,0 +1,227 @@
+#ifndef NOARR_STRUCTURES_CACHE_TILE_HPP
+#define NOARR_STRUCTURES_CACHE_TILE_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include "../base/signature.hpp"
+#include "../base/structs_common.hpp"
+#include "../base/utility.hpp"
+#include "../structs/blocks.hpp"
+#include "../structs/views.hpp"
+#include "../extra/shortcuts.hpp"
+#include "../extra/struct_traits.hpp"
+#include "../extra/to_struct.hpp"
+#include "../extra/traverser.hpp"
+
+namespace noarr {
+
+/**
+ * @brief the sizes (in bytes) of the data caches used for tiling (see `cache_tile`); a size of zero disables the corresponding level
+ */
+struct cache_info {
+	std::size_t l1 = 32 * 1024;
+	std::size_t l2 = 1024 * 1024;
+	std::size_t l3 = 8 * 1024 * 1024;
+
+	/**
+	 * @brief parses a cache size in the format of sysfs and of the environment overrides (e.g. `48K`, `2048K`, `8M`, `32768`),
+	 * returns zero for an invalid size
+	 */
+	static std::size_t parse_size(const std::string &text) noexcept {
+		std::size_t value = 0, i = 0;
+		for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; i++)
+			value = value * 10 + std::size_t(text[i] - '0');
+		if (i == 0)
+			return 0;
+		switch (i < text.size() ? text[i] : '\0') {
+		case 'G': case 'g': return value << 30;
+		case 'M': case 'm': return value << 20;
+		case 'K': case 'k': return value << 10;
+		default: return value;
+		}
+	}
+
+	/**
+	 * @brief reads the sizes of the data (or unified) caches of the first CPU from sysfs (`path`);
+	 * the levels that cannot be read keep the defaults. The sizes can then be overridden by the environment variables
+	 * `NOARR_CACHE_L1`, `NOARR_CACHE_L2` and `NOARR_CACHE_L3` (in the same format as in sysfs, see `parse_size`)
+	 */
+	static cache_info detect(const std::string &path = "/sys/devices/system/cpu/cpu0/cache") {
+		cache_info info;
+
+		for (std::size_t index = 0; ; index++) {
+			const std::string dir = path + "/index" + std::to_string(index) + "/";
+			std::ifstream level_file(dir + "level"), type_file(dir + "type"), size_file(dir + "size");
+			if (!level_file || !type_file || !size_file)
+				break;
+
+			std::size_t level = 0;
+			std::string type, size;
+			level_file >> level;
+			type_file >> type;
+			size_file >> size;
+
+			if (type == "Instruction" || parse_size(size) == 0)
+				continue;
+			if (level == 1)
+				info.l1 = parse_size(size);
+			else if (level == 2)
+				info.l2 = parse_size(size);
+			else if (level == 3)
+				info.l3 = parse_size(size);
+		}
+
+		info.override_from_env("NOARR_CACHE_L1", info.l1);
+		info.override_from_env("NOARR_CACHE_L2", info.l2);
+		info.override_from_env("NOARR_CACHE_L3", info.l3);
+		return info;
+	}
+
+	/**
+	 * @brief the cache sizes of the machine, detected by `detect` on the first call (the same for all the later calls)
+	 */
+	static const cache_info &detected() {
+		static const cache_info info = detect();
+		return info;
+	}
+
+private:
+	static void override_from_env(const char *name, std::size_t &size) {
+		if (const char *value = std::getenv(name))
+			size = parse_size(value);
+	}
+};
+
+namespace helpers {
+
+// the number of bytes of a tile with `side` indices in each tiled dimension: each structure contributes its element size
+// times the number of its elements in the tile (structures without a tiled dimension are reused along it)
+template<class Struct, auto ...Dims>
+struct cache_tile_footprint {
+	static constexpr std::size_t tiled_dims = (0 + ... + std::size_t(Struct::signature::template any_accept<Dims>));
+
+	static constexpr std::size_t bytes(std::size_t side, std::size_t limit) noexcept {
+		std::size_t bytes = sizeof(scalar_t<Struct>);
+		for (std::size_t i = 0; i < tiled_dims; i++) {
+			if (bytes > limit / side)
+				return limit + 1;
+			bytes *= side;
+		}
+		return bytes;
+	}
+};
+
+template<class Struct, auto ...Dims>
+struct cache_tile_footprints {
+	static constexpr std::size_t bytes(std::size_t side, std::size_t limit) noexcept {
+		return cache_tile_footprint<Struct, Dims...>::bytes(side, limit);
+	}
+};
+
+template<class ...Structs, auto ...Dims>
+struct cache_tile_footprints<union_t<Structs...>, Dims...> {
+	static constexpr std::size_t bytes(std::size_t side, std::size_t limit) noexcept {
+		std::size_t total = 0;
+		for (std::size_t part : {cache_tile_footprint<typename to_struct<Structs>::type, Dims...>::bytes(side, limit)...}) {
+			if (part > limit - total)
+				return limit + 1;
+			total += part;
+		}
+		return total;
+	}
+};
+
+} // namespace helpers
+
+/**
+ * @brief multi-level tiling derived from the cache sizes: each of the dimensions `Dims` is split into tiles for L3, L2 and L1
+ * (indexed by `derived_dim<Dim, '3'>`, `derived_dim<Dim, '2'>` and `derived_dim<Dim, '1'>`, the original dimension indexes the elements
+ * of the L1 tile); the tile indices of the outer levels are the outermost, the tiled dimensions are then traversed in the given order
+ *
+ * The tiles are cubes whose side is the largest one for which the tile of all the structures in the traversal (see `tile_side`)
+ * fits into half of the cache (the other half is left for the other data and for conflict misses); the sides of the outer levels
+ * are rounded down to multiples of the inner ones. The last tile in each dimension may be shorter (see `into_blocks_clamped`).
+ * A level whose cache size is zero is not tiled: its dimensions are kept (of length one), its tiles are those of the next outer level.
+ */
+template<auto ...Dims> requires IsDimPack<decltype(Dims)...>
+struct cache_tile_proto {
+	static_assert(sizeof...(Dims) > 0, "At least one dimension has to be tiled");
+
+	std::size_t l1, l2, l3;
+
+	static constexpr bool proto_preserves_layout = true;
+
+	/**
+	 * @brief returns the side of a tile of the structure `Struct` (or of a union of structures) that fits into `capacity` bytes
+	 */
+	template<class Struct>
+	static constexpr std::size_t tile_side(std::size_t capacity) noexcept {
+		using footprints = helpers::cache_tile_footprints<Struct, Dims...>;
+		if (capacity == 0 || footprints::bytes(1, capacity) > capacity)
+			return 1;
+		std::size_t lo = 1, hi = capacity;
+		while (lo < hi) {
+			const std::size_t mid = hi - (hi - lo) / 2;
+			if (footprints::bytes(mid, capacity) <= capacity)
+				lo = mid;
+			else
+				hi = mid - 1;
+		}
+		return lo;
+	}
+
+	template<class Struct>
+	constexpr auto instantiate_and_construct(Struct s) const noexcept {
+		// the sides of the enabled levels (zero for the disabled ones), each rounded to the nearest enabled inner level
+		std::size_t sides[3] = {l1 ? tile_side<Struct>(l1 / 2) : 0, l2 ? tile_side<Struct>(l2 / 2) : 0, l3 ? tile_side<Struct>(l3 / 2) : 0};
+		for (std::size_t level = 0, inner = 0; level < 3; level++) {
+			if (sides[level] == 0)
+				continue;
+			if (inner != 0)
+				sides[level] = round_side(sides[level], inner);
+			inner = sides[level];
+		}
+
+		// a disabled level does not tile: its tile is that of the nearest enabled outer level (or the whole dimension)
+		for (std::size_t level = 3, outer = 0; level-- > 0;) {
+			if (sides[level] == 0)
+				sides[level] = outer;
+			else
+				outer = sides[level];
+		}
+		const auto side = [&]<auto Dim>(std::size_t level) -> std::size_t {
+			if (sides[level] != 0)
+				return sides[level];
+			const std::size_t length = s.template length<Dim>(empty_state);
+			return length != 0 ? length : 1;
+		};
+
+		return s ^
+			(... ^ into_blocks_clamped<Dims, derived_dim<Dims, '3'>>(side.template operator()<Dims>(2))) ^
+			(... ^ into_blocks_clamped<Dims, derived_dim<Dims, '2'>>(side.template operator()<Dims>(1))) ^
+			(... ^ into_blocks_clamped<Dims, derived_dim<Dims, '1'>>(side.template operator()<Dims>(0))) ^
+			hoist<derived_dim<Dims, '3'>..., derived_dim<Dims, '2'>..., derived_dim<Dims, '1'>..., Dims...>();
+	}
+
+private:
+	static constexpr std::size_t round_side(std::size_t side, std::size_t inner) noexcept {
+		return side < inner ? inner : side - side % inner;
+	}
+};
+
+/**
+ * @brief tiles the dimensions `Dims` for the caches described by `info` (see `cache_tile_proto`)
+ *
+ * @param info: the cache sizes, detected from sysfs once by default (see `cache_info::detected`)
+ */
+template<auto ...Dims> requires IsDimPack<decltype(Dims)...>
+inline auto cache_tile(const cache_info &info = cache_info::detected()) {
+	return cache_tile_proto<Dims...>{info.l1, info.l2, info.l3};
+}
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_CACHE_TILE_HPP
@@ -0,0 +1,205 @@
+#ifndef NOARR_STRUCTURES_EXPR_HPP
+#define NOARR_STRUCTURES_EXPR_HPP
+
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../base/contain.hpp"
+#include "../base/state.hpp"
+#include "../base/structs_common.hpp"
+#include "../base/utility.hpp"
+#include "../interop/bag.hpp"
+#include "../extra/traverser.hpp"
+
+namespace noarr {
+
+template<class Bag, class Order>
+struct bag_expr_t;
+
+template<class T>
+struct scalar_expr_t;
+
+template<class Op, class Lhs, class Rhs>
+struct binary_expr_t;
+
+template<class Op, class Arg>
+struct unary_expr_t;
+
+namespace helpers {
+
+template<class T>
+struct is_expr : std::false_type {};
+
+template<class Bag, class Order>
+struct is_expr<bag_expr_t<Bag, Order>> : std::true_type {};
+
+template<class T>
+struct is_expr<scalar_expr_t<T>> : std::true_type {};
+
+template<class Op, class Lhs, class Rhs>
+struct is_expr<binary_expr_t<Op, Lhs, Rhs>> : std::true_type {};
+
+template<class Op, class Arg>
+struct is_expr<unary_expr_t<Op, Arg>> : std::true_type {};
+
+} // namespace helpers
+
+template<class T>
+concept IsExpr = helpers::is_expr<std::remove_cvref_t<T>>::value;
+
+// an operand of an expression: an expression, a bag (evaluated at the state) or a scalar (broadcast to all states)
+template<class T>
+concept IsExprOperand = IsExpr<T> || IsBag<std::remove_cvref_t<T>> || std::is_arithmetic_v<std::remove_cvref_t<T>>;
+
+/**
+ * @brief converts an operand of an expression (see `IsExprOperand`) to an expression
+ */
+template<IsExprOperand T>
+constexpr auto to_expr(const T &operand) noexcept {
+	if constexpr (IsExpr<T>)
+		return operand;
+	else if constexpr (IsBag<T>)
+		return bag_expr_t<decltype(operand.get_ref()), neutral_proto>(operand.get_ref(), neutral_proto());
+	else
+		return scalar_expr_t<T>{operand};
+}
+
+/**
+ * @brief a scalar broadcast to all the states
+ */
+template<class T>
+struct scalar_expr_t {
+	T value;
+
+	constexpr std::tuple<> bags() const noexcept { return {}; }
+	constexpr T operator[](IsState auto) const noexcept { return value; }
+};
+
+/**
+ * @brief an element-wise operation `Op` applied to two expressions
+ */
+template<class Op, class Lhs, class Rhs>
+struct binary_expr_t {
+	Lhs lhs;
+	Rhs rhs;
+
+	constexpr auto bags() const noexcept { return std::tuple_cat(lhs.bags(), rhs.bags()); }
+	constexpr auto operator[](IsState auto state) const noexcept { return Op()(lhs[state], rhs[state]); }
+};
+
+/**
+ * @brief an element-wise operation `Op` applied to an expression
+ */
+template<class Op, class Arg>
+struct unary_expr_t {
+	Arg arg;
+
+	constexpr auto bags() const noexcept { return arg.bags(); }
+	constexpr auto operator[](IsState auto state) const noexcept { return Op()(arg[state]); }
+};
+
+/**
+ * @brief an expression reading (or, as the target of an assignment, writing) the elements of a bag;
+ * the bag ignores the indices of the dimensions it does not have, so it is broadcast over them
+ *
+ * The assignment evaluates the right-hand side in a single traversal of the union of all the bags involved
+ * (in the order given by `order()`, see `operator^`). If the target does not have some of the traversed dimensions,
+ * the assignment is repeated for each of their indices (a reduction, e.g. `expr(x) = expr(x) + expr(A) * y`).
+ * The target may also appear on the right-hand side, but only in the same shape (not e.g. transposed).
+ */
+template<class Bag, class Order>
+struct bag_expr_t : strict_contain<Bag, Order> {
+	using strict_contain<Bag, Order>::strict_contain;
+
+	constexpr bag_expr_t(const bag_expr_t &) noexcept = default;
+
+	constexpr Bag bag() const noexcept { return this->template get<0>(); }
+	constexpr Order order() const noexcept { return this->template get<1>(); }
+
+	constexpr std::tuple<Bag> bags() const noexcept { return {bag()}; }
+	constexpr decltype(auto) operator[](IsState auto state) const noexcept { return bag()[state]; }
+
+	/**
+	 * @brief returns the expression with the order of the traversal of the assignment changed by `new_order`
+	 */
+	template<class NewOrder>
+	constexpr auto operator^(NewOrder new_order) const noexcept {
+		return bag_expr_t<Bag, decltype(order() ^ new_order)>(bag(), order() ^ new_order);
+	}
+
+	// an assignment of an expression of the same type (as any other expression) evaluates it
+	constexpr const bag_expr_t &operator=(const bag_expr_t &src) const { return assign(src, std::identity()); }
+
+	template<IsExprOperand Src>
+	constexpr const bag_expr_t &operator=(const Src &src) const { return assign(src, std::identity()); }
+
+	template<IsExprOperand Src>
+	constexpr const bag_expr_t &operator+=(const Src &src) const { return assign(src, std::plus<>()); }
+
+	template<IsExprOperand Src>
+	constexpr const bag_expr_t &operator-=(const Src &src) const { return assign(src, std::minus<>()); }
+
+	template<IsExprOperand Src>
+	constexpr const bag_expr_t &operator*=(const Src &src) const { return assign(src, std::multiplies<>()); }
+
+	template<IsExprOperand Src>
+	constexpr const bag_expr_t &operator/=(const Src &src) const { return assign(src, std::divides<>()); }
+
+private:
+	template<class Src, class Op>
+	constexpr const bag_expr_t &assign(const Src &src, Op) const {
+		const auto value = to_expr(src);
+		const auto target = bag();
+
+		std::apply([&](const auto &...bags) {
+			traverser(target, bags...) ^ order() | [=](auto state) {
+				if constexpr (std::is_same_v<Op, std::identity>)
+					target[state] = value[state];
+				else
+					target[state] = Op()(target[state], value[state]);
+			};
+		}, value.bags());
+
+		return *this;
+	}
+};
+
+/**
+ * @brief wraps a bag into an expression (see `bag_expr_t`); expressions can be combined with bags and scalars
+ * using `+`, `-`, `*`, `/` and unary `-`, and they are evaluated lazily, in a single traversal, when assigned to `expr(target)`
+ */
+template<class Bag> requires IsBag<Bag>
+constexpr auto expr(const Bag &bag) noexcept {
+	return bag_expr_t<decltype(bag.get_ref()), neutral_proto>(bag.get_ref(), neutral_proto());
+}
+
+template<IsExprOperand Lhs, IsExprOperand Rhs> requires (IsExpr<Lhs> || IsExpr<Rhs>)
+constexpr auto operator+(const Lhs &lhs, const Rhs &rhs) noexcept {
+	return binary_expr_t<std::plus<>, decltype(to_expr(lhs)), decltype(to_expr(rhs))>{to_expr(lhs), to_expr(rhs)};
+}
+
+template<IsExprOperand Lhs, IsExprOperand Rhs> requires (IsExpr<Lhs> || IsExpr<Rhs>)
+constexpr auto operator-(const Lhs &lhs, const Rhs &rhs) noexcept {
+	return binary_expr_t<std::minus<>, decltype(to_expr(lhs)), decltype(to_expr(rhs))>{to_expr(lhs), to_expr(rhs)};
+}
+
+template<IsExprOperand Lhs, IsExprOperand Rhs> requires (IsExpr<Lhs> || IsExpr<Rhs>)
+constexpr auto operator*(const Lhs &lhs, const Rhs &rhs) noexcept {
+	return binary_expr_t<std::multiplies<>, decltype(to_expr(lhs)), decltype(to_expr(rhs))>{to_expr(lhs), to_expr(rhs)};
+}
+
+template<IsExprOperand Lhs, IsExprOperand Rhs> requires (IsExpr<Lhs> || IsExpr<Rhs>)
+constexpr auto operator/(const Lhs &lhs, const Rhs &rhs) noexcept {
+	return binary_expr_t<std::divides<>, decltype(to_expr(lhs)), decltype(to_expr(rhs))>{to_expr(lhs), to_expr(rhs)};
+}
+
+template<IsExpr Arg>
+constexpr auto operator-(const Arg &arg) noexcept {
+	return unary_expr_t<std::negate<>, Arg>{arg};
+}
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_EXPR_HPP
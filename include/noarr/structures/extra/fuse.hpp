@@ -0,0 +1,98 @@
+#ifndef NOARR_STRUCTURES_FUSE_HPP
+#define NOARR_STRUCTURES_FUSE_HPP
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../base/utility.hpp"
+#include "../extra/traverser.hpp"
+
+namespace noarr {
+
+namespace helpers {
+
+// the bodies restricted to some dimensions of the fused traversal (see `for_each`, `for_dims` and `for_sections`)
+template<class T>
+struct fuse_restricted_body : std::false_type {
+	template<class Signature>
+	static constexpr bool dims_accepted = true;
+	template<auto Dim>
+	static constexpr bool dim_restricted = false;
+};
+
+template<class F, auto ...Dims>
+struct fuse_restricted_body<for_each_t<F, Dims...>> : std::true_type {
+	template<class Signature>
+	static constexpr bool dims_accepted = (... && Signature::template any_accept<Dims>);
+	template<auto Dim>
+	static constexpr bool dim_restricted = (false || ... || (Dim == Dims));
+};
+
+template<class F, auto ...Dims>
+struct fuse_restricted_body<for_dims_t<F, Dims...>> : fuse_restricted_body<for_each_t<F, Dims...>> {};
+
+template<class F, auto ...Dims>
+struct fuse_restricted_body<for_sections_t<F, Dims...>> : fuse_restricted_body<for_each_t<F, Dims...>> {};
+
+template<class Bodies, auto ...Dims> requires IsDimPack<decltype(Dims)...>
+struct fuse_t {
+	Bodies bodies;
+};
+
+template<class Body, auto ...Dims>
+constexpr void fuse_check_body() noexcept {
+	static_assert((... && !fuse_restricted_body<Body>::template dim_restricted<Dims>), "A body of a fused traversal cannot traverse the fused dimensions");
+}
+
+} // namespace helpers
+
+/**
+ * @brief fuses several traversal bodies into a single loop nest: the traverser it is applied to (via `|`) traverses
+ * the dimensions `Dims` once and, for each combination of their indices, the bodies are executed in the given order
+ *
+ * Each body is either a function receiving the inner traverser (as in `for_dims<Dims...>`) or a body restricted
+ * to some of the remaining dimensions (`for_each<...>(f)`, `for_dims<...>(f)` or `for_sections<...>(f)`), which is applied to the inner traverser.
+ * If `Dims` is empty, all the dimensions are traversed once and each body receives the state.
+ *
+ * The fusion is legal if no body depends on results of a later body (in the original order of the passes)
+ * computed for a different combination of the indices in `Dims`. These dependences are NOT checked (the bodies are
+ * opaque functions): only the dimensions are, i.e. that the fused dimensions and those the bodies are restricted to exist
+ * and that no body traverses a fused dimension. The fusion also changes the order of the accesses: if `Dims` are not
+ * the outer dimensions of the layouts, the bodies walk the data with a stride (it may be slower than the separate passes).
+ */
+template<auto ...Dims, class ...Bodies> requires IsDimPack<decltype(Dims)...>
+constexpr auto fuse(Bodies ...bodies) noexcept {
+	static_assert(sizeof...(Bodies) > 0, "At least one body has to be fused");
+	(..., helpers::fuse_check_body<Bodies, Dims...>());
+	return helpers::fuse_t<std::tuple<Bodies...>, Dims...>{std::tuple<Bodies...>(bodies...)};
+}
+
+template<IsTraverser T, class Bodies, auto ...Dims>
+constexpr void operator|(const T &t, const helpers::fuse_t<Bodies, Dims...> &fused) {
+	using signature = typename decltype(t.top_struct())::signature;
+	static_assert((... && signature::template any_accept<Dims>), "The traversal does not have the fused dimension");
+
+	if constexpr (sizeof...(Dims) == 0) {
+		std::apply([&t](const auto &...bodies) {
+			static_assert((... && !helpers::fuse_restricted_body<std::remove_cvref_t<decltype(bodies)>>::value), "A body restricted to some dimensions needs a fused dimension to be applied to");
+			t.for_each([&bodies...](auto state) { (..., bodies(state)); });
+		}, fused.bodies);
+	} else {
+		std::apply([&t](const auto &...bodies) {
+			static_assert((... && helpers::fuse_restricted_body<std::remove_cvref_t<decltype(bodies)>>::template dims_accepted<signature>), "The traversal does not have a dimension a fused body is restricted to");
+			t.template for_dims<Dims...>([&bodies...](auto inner) {
+				([&inner](const auto &body) {
+					if constexpr (helpers::fuse_restricted_body<std::remove_cvref_t<decltype(body)>>::value)
+						inner | body;
+					else
+						body(inner);
+				}(bodies), ...);
+			});
+		}, fused.bodies);
+	}
+}
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_FUSE_HPP
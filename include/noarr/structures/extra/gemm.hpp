@@ -0,0 +1,272 @@
+#ifndef NOARR_STRUCTURES_GEMM_HPP
+#define NOARR_STRUCTURES_GEMM_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#include "../base/utility.hpp"
+#include "../extra/auto_order.hpp"
+#include "../extra/cache_tile.hpp"
+#include "../extra/pack_tile.hpp"
+#include "../extra/shortcuts.hpp"
+#include "../extra/struct_traits.hpp"
+
+namespace noarr {
+
+namespace helpers {
+
+// the width of the vector registers (in bytes) the micro-kernel is shaped for
+#if defined(__AVX512F__)
+constexpr std::size_t gemm_vector_bytes = 64;
+#elif defined(__AVX__)
+constexpr std::size_t gemm_vector_bytes = 32;
+#else
+constexpr std::size_t gemm_vector_bytes = 16;
+#endif
+
+// the dimensions of a matrix product `C[i, j] = A[i, k] * B[k, j]` inferred from the dimensions of the three matrices
+template<class CDims, class ADims, class BDims>
+struct gemm_dims {
+	static_assert(value_always_false<CDims>, "The matrices of a matrix product must have two dimensions each");
+};
+
+template<auto C0, auto C1, auto A0, auto A1, auto B0, auto B1>
+struct gemm_dims<dim_sequence<C0, C1>, dim_sequence<A0, A1>, dim_sequence<B0, B1>> {
+	using c = dim_sequence<C0, C1>;
+	using a = dim_sequence<A0, A1>;
+	using b = dim_sequence<B0, B1>;
+
+	static constexpr bool c0_in_a = a::template contains<C0>;
+
+	static constexpr auto i = [] { if constexpr (c0_in_a) return C0; else return C1; }();
+	static constexpr auto j = [] { if constexpr (c0_in_a) return C1; else return C0; }();
+	static constexpr auto k = [] { if constexpr (A0 == i) return A1; else return A0; }();
+
+	static_assert(a::template contains<i> && !b::template contains<i>, "The row dimension of C must be in A (and not in B)");
+	static_assert(b::template contains<j> && !a::template contains<j>, "The column dimension of C must be in B (and not in A)");
+	static_assert(b::template contains<k> && !c::template contains<k>, "The inner dimension of A must be in B (and not in C)");
+};
+
+template<class Bag>
+using gemm_bag_dims = typename auto_order_sig_dims<typename decltype(std::declval<const Bag &>().structure())::signature>::type;
+
+// the register block of the micro-kernel (`mr` rows of C times `nr` columns, two vectors), it takes `2 * mr + 3` of the vector registers
+// (there are 32 of them with AVX-512 and 16 otherwise)
+template<class T>
+struct gemm_shape {
+	static constexpr std::size_t mr = gemm_vector_bytes == 64 ? 12 : 6;
+	static constexpr std::size_t nr = std::max<std::size_t>(2 * gemm_vector_bytes / sizeof(T), 2);
+};
+
+#if defined(__GNUC__) || defined(__clang__)
+// a vector register of `T` (GCC vector extensions)
+template<class T>
+struct gemm_vector {
+	typedef T type __attribute__((vector_size(gemm_vector_bytes)));
+};
+#endif
+
+// `acc = a * b` for a packed panel of `mr` rows of A and a packed panel of `nr` columns of B (the `kc` elements of the inner dimension)
+template<class T>
+inline void gemm_micro_kernel(std::size_t kc, const T *__restrict a, const T *__restrict b, T *__restrict acc) noexcept {
+	constexpr std::size_t mr = gemm_shape<T>::mr;
+	constexpr std::size_t nr = gemm_shape<T>::nr;
+
+#if defined(__GNUC__) || defined(__clang__)
+	if constexpr (std::is_arithmetic_v<T> && gemm_vector_bytes % sizeof(T) == 0 && nr * sizeof(T) == 2 * gemm_vector_bytes) {
+		// the `mr` x `nr` block of C in `2 * mr` vector registers, a row of the panel of B in two more
+		using vector = typename gemm_vector<T>::type;
+		constexpr std::size_t w = gemm_vector_bytes / sizeof(T);
+
+		vector c[mr][2] = {};
+		for (std::size_t p = 0; p < kc; p++, a += mr, b += nr) {
+			vector b0, b1;
+			__builtin_memcpy(&b0, b, sizeof(vector));
+			__builtin_memcpy(&b1, b + w, sizeof(vector));
+			for (std::size_t r = 0; r < mr; r++) {
+				c[r][0] += a[r] * b0;
+				c[r][1] += a[r] * b1;
+			}
+		}
+
+		for (std::size_t r = 0; r < mr; r++) {
+			__builtin_memcpy(acc + r * nr, &c[r][0], sizeof(vector));
+			__builtin_memcpy(acc + r * nr + w, &c[r][1], sizeof(vector));
+		}
+		return;
+	}
+#endif
+
+	T c[mr][nr] = {};
+	for (std::size_t p = 0; p < kc; p++, a += mr, b += nr)
+		for (std::size_t r = 0; r < mr; r++)
+			for (std::size_t s = 0; s < nr; s++)
+				c[r][s] += a[r] * b[s];
+
+	for (std::size_t r = 0; r < mr; r++)
+		for (std::size_t s = 0; s < nr; s++)
+			acc[r * nr + s] = c[r][s];
+}
+
+// the sizes of the cache blocks: a `kc`-long panel of B fits into L1, an `mc` x `kc` block of A into half of L2 and a `kc` x `nc` block of B into half of L3
+template<class T>
+struct gemm_blocking {
+	std::size_t mc, nc, kc;
+
+	explicit gemm_blocking(const cache_info &info) noexcept {
+		constexpr std::size_t mr = gemm_shape<T>::mr;
+		constexpr std::size_t nr = gemm_shape<T>::nr;
+		const cache_info defaults;
+		const std::size_t l1 = info.l1 ? info.l1 : defaults.l1;
+		const std::size_t l2 = info.l2 ? info.l2 : defaults.l2;
+		const std::size_t l3 = info.l3 ? info.l3 : defaults.l3;
+
+		kc = std::clamp<std::size_t>(l1 / (nr * sizeof(T)), 64, 512);
+		mc = std::max<std::size_t>(l2 / 2 / (kc * sizeof(T)) / mr, 1) * mr;
+		nc = std::max<std::size_t>(l3 / 2 / (kc * sizeof(T)) / nr, 1) * nr;
+	}
+};
+
+struct gemm_sequential {
+	template<class F>
+	void operator()(std::size_t n, const F &f) const {
+		for (std::size_t b = 0; b < n; b++)
+			f(b);
+	}
+};
+
+// the number of the panels of A (of `mr` rows each) multiplied by a panel of B in a single task of `gemm_impl`
+constexpr std::size_t gemm_a_panels_per_task = 4;
+
+/**
+ * @brief `C = alpha * A * B + beta * C` (see `gemm`), the independent parts of each step are run by `exec(num_tasks, f)`
+ * (which calls `f(task)` for each task, possibly in parallel, and returns when all of them are done)
+ *
+ * For each block of B, its panels are packed by separate tasks. Then, for each block of the rows of A, the panels of the block
+ * are packed by separate tasks and the block of C is computed by tasks that each multiply a few panels of A by a panel of B
+ * (like the `jr` and `ir` loops of BLIS), so even a product with a single block of rows is split among all the threads.
+ */
+template<auto DimI, auto DimJ, auto DimK, class Exec, class CBag, class ABag, class BBag, class Scalar>
+inline void gemm_impl(const Exec &exec, const CBag &C, const ABag &A, const BBag &B, Scalar alpha, Scalar beta) {
+	using T = std::remove_cvref_t<decltype(C[idx<DimI, DimJ>(0, 0)])>;
+	constexpr std::size_t mr = gemm_shape<T>::mr;
+	constexpr std::size_t nr = gemm_shape<T>::nr;
+
+	const std::size_t m = C | get_length<DimI>();
+	const std::size_t n = C | get_length<DimJ>();
+	const std::size_t k = A | get_length<DimK>();
+	assert((A | get_length<DimI>()) == m && "The rows of A and C differ in length");
+	assert((B | get_length<DimJ>()) == n && "The columns of B and C differ in length");
+	assert((B | get_length<DimK>()) == k && "The inner dimensions of A and B differ in length");
+	const gemm_blocking<T> blocking(cache_info::detected());
+	const T t_alpha = T(alpha), t_beta = T(beta);
+
+	// `C = beta * C` for an empty product, then the blocks of the inner dimension are accumulated (the first one scales C)
+	if (k == 0) {
+		exec(m, [&](std::size_t i) {
+			for (std::size_t j = 0; j < n; j++) {
+				auto &&c = C[idx<DimI, DimJ>(i, j)];
+				c = t_beta == T(0) ? T(0) : T(t_beta * c);
+			}
+		});
+		return;
+	}
+
+	for (std::size_t jc = 0; jc < n; jc += blocking.nc) {
+		const std::size_t nc = std::min(blocking.nc, n - jc);
+		const std::size_t panels_b = (nc + nr - 1) / nr;
+
+		for (std::size_t pc = 0; pc < k; pc += blocking.kc) {
+			const std::size_t kc = std::min(blocking.kc, k - pc);
+			const bool first = pc == 0;
+
+			// B[pc : pc + kc, jc : jc + nc] packed into panels of `nr` columns, each row of a panel contiguous (padded by zeros)
+			const pack_tile_buffer b_buffer(panels_b * kc * nr * sizeof(T));
+			T *const b_packed = static_cast<T *>(b_buffer.get());
+			exec(panels_b, [&](std::size_t q) {
+				for (std::size_t p = 0; p < kc; p++)
+					for (std::size_t s = 0; s < nr; s++) {
+						const std::size_t j = q * nr + s;
+						b_packed[(q * kc + p) * nr + s] = j < nc ? T(B[idx<DimK, DimJ>(pc + p, jc + j)]) : T(0);
+					}
+			});
+
+			const pack_tile_buffer a_buffer((std::min(blocking.mc, m) + mr - 1) / mr * kc * mr * sizeof(T));
+			T *const a_packed = static_cast<T *>(a_buffer.get());
+
+			for (std::size_t ic = 0; ic < m; ic += blocking.mc) {
+				const std::size_t mc = std::min(blocking.mc, m - ic);
+				const std::size_t panels_a = (mc + mr - 1) / mr;
+				const std::size_t groups_a = (panels_a + gemm_a_panels_per_task - 1) / gemm_a_panels_per_task;
+
+				// A[ic : ic + mc, pc : pc + kc] packed into panels of `mr` rows, each column of a panel contiguous (padded by zeros)
+				exec(panels_a, [&](std::size_t q) {
+					for (std::size_t p = 0; p < kc; p++)
+						for (std::size_t r = 0; r < mr; r++) {
+							const std::size_t i = q * mr + r;
+							a_packed[(q * kc + p) * mr + r] = i < mc ? T(A[idx<DimI, DimK>(ic + i, pc + p)]) : T(0);
+						}
+				});
+
+				// the panels of B in the outer order, so the consecutive tasks of a thread share the panel of B (it stays in L1)
+				exec(panels_b * groups_a, [&](std::size_t task) {
+					const std::size_t qb = task / groups_a;
+					const std::size_t qa_begin = task % groups_a * gemm_a_panels_per_task;
+					const std::size_t qa_end = std::min(qa_begin + gemm_a_panels_per_task, panels_a);
+					const std::size_t j0 = qb * nr;
+					const std::size_t nr_used = std::min(nr, nc - j0);
+
+					T acc[mr * nr];
+					for (std::size_t qa = qa_begin; qa < qa_end; qa++) {
+						const std::size_t i0 = qa * mr;
+						const std::size_t mr_used = std::min(mr, mc - i0);
+						gemm_micro_kernel<T>(kc, a_packed + qa * kc * mr, b_packed + qb * kc * nr, acc);
+
+						for (std::size_t r = 0; r < mr_used; r++)
+							for (std::size_t s = 0; s < nr_used; s++) {
+								auto &&c = C[idx<DimI, DimJ>(ic + i0 + r, jc + j0 + s)];
+								if (!first)
+									c = T(c + t_alpha * acc[r * nr + s]);
+								else if (t_beta == T(0))
+									c = T(t_alpha * acc[r * nr + s]);
+								else
+									c = T(t_beta * c + t_alpha * acc[r * nr + s]);
+							}
+					}
+				});
+			}
+		}
+	}
+}
+
+} // namespace helpers
+
+/**
+ * @brief the matrix product `C = alpha * A * B + beta * C`, with the rows of C in the dimension `DimI`, its columns in `DimJ`
+ * and the inner dimension `DimK` (so `A` has the dimensions `DimI` and `DimK` and `B` has `DimK` and `DimJ`)
+ *
+ * The matrices can have any layouts (e.g. a transposed matrix is just a `rename`d view). The blocks of A and B that fit
+ * into the caches (see `cache_info::detected`) are packed into contiguous buffers, from which a register-blocked micro-kernel
+ * computes the blocks of C. If `beta` is zero, C is not read. For the parallel versions, see `omp_gemm` and `tbb_gemm`.
+ */
+template<auto DimI, auto DimJ, auto DimK, class CBag, class ABag, class BBag, class Scalar>
+requires IsDimPack<decltype(DimI), decltype(DimJ), decltype(DimK)>
+inline void gemm(const CBag &C, const ABag &A, const BBag &B, Scalar alpha, Scalar beta) {
+	helpers::gemm_impl<DimI, DimJ, DimK>(helpers::gemm_sequential(), C, A, B, alpha, beta);
+}
+
+/**
+ * @brief the matrix product `C = alpha * A * B + beta * C` (see above), the dimensions are inferred from the dimensions of the matrices
+ * (the row dimension of C is the one shared with A, its column dimension the one shared with B, the inner dimension is shared by A and B)
+ */
+template<class CBag, class ABag, class BBag, class Scalar>
+inline void gemm(const CBag &C, const ABag &A, const BBag &B, Scalar alpha, Scalar beta) {
+	using dims = helpers::gemm_dims<helpers::gemm_bag_dims<CBag>, helpers::gemm_bag_dims<ABag>, helpers::gemm_bag_dims<BBag>>;
+	gemm<dims::i, dims::j, dims::k>(C, A, B, alpha, beta);
+}
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_GEMM_HPP
@@ -0,0 +1,76 @@
+#ifndef NOARR_STRUCTURES_INVARIANT_HPP
+#define NOARR_STRUCTURES_INVARIANT_HPP
+
+#include <type_traits>
+
+#include "../base/signature.hpp"
+#include "../base/utility.hpp"
+#include "../extra/struct_traits.hpp"
+#include "../extra/traverser.hpp"
+
+namespace noarr {
+
+namespace helpers {
+
+// whether the signature `BagSig` accepts none of the dimensions of the signature `Sig` (in any of its branches)
+template<class BagSig, class Sig>
+struct sig_independent : std::true_type {};
+
+template<class BagSig, IsDim auto Dim, class ArgLength, class RetSig>
+struct sig_independent<BagSig, function_sig<Dim, ArgLength, RetSig>>
+	: std::bool_constant<!BagSig::template any_accept<Dim> && sig_independent<BagSig, RetSig>::value> {};
+
+template<class BagSig, IsDim auto Dim, class ...RetSigs>
+struct sig_independent<BagSig, dep_function_sig<Dim, RetSigs...>>
+	: std::bool_constant<!BagSig::template any_accept<Dim> && (... && sig_independent<BagSig, RetSigs>::value)> {};
+
+template<class Bag, class F>
+struct accumulate_into_t {
+	Bag bag;
+	F f;
+};
+
+} // namespace helpers
+
+/**
+ * @brief whether the element of the bag `Bag` accessed in the traversal `T` is the same for all its states
+ * (i.e. the bag ignores all the dimensions still traversed by `T`, e.g. `A` in the `'j'` loop of `C[i, j] += A[i, k] * B[k, j]`)
+ */
+template<class Bag, IsTraverser T>
+constexpr bool is_invariant_in = helpers::sig_independent<
+	typename decltype(std::declval<const Bag &>().structure())::signature,
+	typename decltype(std::declval<const T &>().top_struct())::signature>::value;
+
+/**
+ * @brief loads the element of `bag` that is the same for all the states of the traverser `t` (see `is_invariant_in`),
+ * so that it is read once (before the traversal) instead of in each iteration, where the compiler could not prove
+ * that the writes to other bags do not change it
+ */
+template<class Bag, IsTraverser T>
+constexpr auto invariant(const Bag &bag, const T &t) noexcept {
+	static_assert(is_invariant_in<Bag, T>, "The element of the bag depends on the traversed dimensions");
+	return scalar_t<decltype(bag.structure())>(bag[t]);
+}
+
+/**
+ * @brief scalar replacement of an accumulator: the traverser it is applied to (via `|`) calls `f(acc, state)` for all its states,
+ * where `acc` is a local copy of the element of `bag` that is the same for all the states (see `is_invariant_in`);
+ * the element is loaded before the traversal and stored after it, so the accumulator stays in a register
+ *
+ * The other bags must not access the element during the traversal (e.g. a triangular solve reading only the preceding elements is fine).
+ */
+template<class Bag, class F>
+constexpr auto accumulate_into(const Bag &bag, F f) noexcept {
+	return helpers::accumulate_into_t<Bag, F>{bag, f};
+}
+
+template<IsTraverser T, class Bag, class F>
+constexpr void operator|(const T &t, const helpers::accumulate_into_t<Bag, F> &a) {
+	auto acc = invariant(a.bag, t);
+	t.for_each([&acc, &a](auto state) { a.f(acc, state); });
+	a.bag[t] = acc;
+}
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_INVARIANT_HPP
@@ -0,0 +1,221 @@
+#ifndef NOARR_STRUCTURES_PACK_TILE_HPP
+#define NOARR_STRUCTURES_PACK_TILE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../base/state.hpp"
+#include "../base/utility.hpp"
+#include "../extra/auto_order.hpp"
+#include "../extra/shortcuts.hpp"
+#include "../extra/struct_traits.hpp"
+#include "../extra/traverser.hpp"
+#include "../interop/bag.hpp"
+
+namespace noarr {
+
+namespace helpers {
+
+// the thread-local buffers of the packed tiles, one for each nesting level of `pack_tile` (reused by the consecutive tiles)
+class pack_tile_buffers {
+	static constexpr std::size_t alignment = 64;
+
+	struct deleter {
+		void operator()(void *p) const noexcept { ::operator delete(p, std::align_val_t(alignment)); }
+	};
+
+	struct buffer {
+		std::unique_ptr<void, deleter> data;
+		std::size_t size = 0;
+	};
+
+	std::vector<buffer> buffers;
+	std::size_t depth = 0;
+
+	static pack_tile_buffers &local() {
+		thread_local pack_tile_buffers buffers;
+		return buffers;
+	}
+
+	friend class pack_tile_buffer;
+
+	// a buffer of at least `size` bytes, valid until the matching `release`
+	static void *acquire(std::size_t size) {
+		auto &self = local();
+		if (self.depth == self.buffers.size())
+			self.buffers.emplace_back();
+		auto &b = self.buffers[self.depth];
+		if (b.size < size) {
+			// allocated before anything is changed, so that a `bad_alloc` leaves the buffer (and the depth) as it was
+			std::unique_ptr<void, deleter> data(::operator new(size, std::align_val_t(alignment)));
+			b.data = std::move(data);
+			b.size = size;
+		}
+		self.depth++;
+		return b.data.get();
+	}
+
+	static void release() noexcept { local().depth--; }
+};
+
+// a thread-local buffer of at least `size` bytes (see `pack_tile_buffers`), held until the object is destroyed (even by an exception)
+class pack_tile_buffer {
+	void *ptr;
+
+public:
+	explicit pack_tile_buffer(std::size_t size) : ptr(pack_tile_buffers::acquire(size)) {}
+	~pack_tile_buffer() { pack_tile_buffers::release(); }
+
+	pack_tile_buffer(const pack_tile_buffer &) = delete;
+	pack_tile_buffer &operator=(const pack_tile_buffer &) = delete;
+
+	void *get() const noexcept { return ptr; }
+};
+
+template<class Dims>
+struct pack_tile_corners;
+
+template<>
+struct pack_tile_corners<dim_sequence<>> {
+	template<class T, IsState State>
+	static constexpr bool get(const T &, State first, State last, auto f) {
+		f(first, last);
+		return true;
+	}
+};
+
+template<auto Dim, auto ...Dims>
+struct pack_tile_corners<dim_sequence<Dim, Dims...>> {
+	// calls `f(first, last)` with the states of the top struct with all the dimensions fixed; returns false for an empty traversal
+	template<class T, IsState First, IsState Last>
+	static constexpr bool get(const T &t, First first, Last last, auto f) {
+		const std::size_t first_len = t.top_struct().template length<Dim>(first);
+		const std::size_t last_len = t.top_struct().template length<Dim>(last);
+		if (first_len == 0 || last_len == 0)
+			return false;
+		return pack_tile_corners<dim_sequence<Dims...>>::get(t,
+			first.template with<index_in<Dim>>(std::size_t(0)), last.template with<index_in<Dim>>(last_len - 1), f);
+	}
+};
+
+template<bool WriteBack, class Bag, class F, auto ...Dims>
+struct pack_tile_t {
+	Bag bag;
+	F f;
+};
+
+} // namespace helpers
+
+/**
+ * @brief a packed tile of a bag (see `pack_tile`), indexed by the same states as the bag
+ * (with the indices in the packed dimensions inside the tile)
+ */
+template<class Buffer, auto ...Dims>
+struct packed_tile_t {
+	Buffer buf;
+	std::array<std::size_t, sizeof...(Dims)> origins;
+
+	template<IsDim auto Dim>
+	static constexpr std::size_t dim_position = [] {
+		std::size_t i = 0;
+		(void)(... || (Dims == Dim || (i++, false)));
+		return i;
+	}();
+
+	/**
+	 * @brief the packed copy of the tile, its indices start at zero (the first of the packed dimensions is contiguous)
+	 */
+	constexpr Buffer buffer() const noexcept { return buf; }
+	constexpr auto structure() const noexcept { return buf.structure(); }
+	constexpr auto data() const noexcept { return buf.data(); }
+
+	/**
+	 * @brief the index of the first element of the tile in the packed dimension `Dim` of the bag
+	 */
+	template<IsDim auto Dim>
+	constexpr std::size_t origin() const noexcept {
+		static_assert(dim_sequence<Dims...>::template contains<Dim>, "The dimension is not packed");
+		return origins[dim_position<Dim>];
+	}
+
+	constexpr decltype(auto) operator[](ToState auto state) const noexcept {
+		const auto s = convert_to_state(state);
+		return buf[idx<Dims...>(std::size_t(s.template get<index_in<Dims>>()) - origin<Dims>()...)];
+	}
+};
+
+/**
+ * @brief copies a tile of `bag` to a contiguous, aligned, thread-local buffer before the traversal it is applied to (via `|`),
+ * calls `f(tile, t)` with the packed tile (see `packed_tile_t`, accessed as the bag, i.e. `tile[state]` instead of `bag[state]`)
+ * and the traversal `t`, and copies the tile back to the bag afterwards (a software-managed cache, as the packing in BLAS)
+ *
+ * The tile consists of the elements of the bag in the traversal: the range of each of the packed dimensions `Dims`
+ * (all the dimensions of the bag) spans from its index in the first state to that in the last state. So the traversal
+ * has to be monotonic in the indices of the bag (as in the blocks made by `into_blocks` or `cache_tile`).
+ * The tile is laid out with the first of `Dims` contiguous (as in `vectors<Dims...>`), choose it to make the innermost
+ * loop read consecutive elements (the layout of the bag may be transposed this way).
+ *
+ * The bag must not be accessed otherwise (through other views of the same data) during the traversal;
+ * for a read-only tile use `pack_tile_in`.
+ */
+template<auto ...Dims, class Bag, class F> requires IsDimPack<decltype(Dims)...>
+constexpr auto pack_tile(const Bag &bag, F f) noexcept {
+	return helpers::pack_tile_t<true, decltype(bag.get_ref()), F, Dims...>{bag.get_ref(), f};
+}
+
+/**
+ * @brief as `pack_tile`, but the tile is only read (it is not copied back, the packed tile is read-only),
+ * so other views of the same data can be written (outside the tile)
+ */
+template<auto ...Dims, class Bag, class F> requires IsDimPack<decltype(Dims)...>
+constexpr auto pack_tile_in(const Bag &bag, F f) noexcept {
+	return helpers::pack_tile_t<false, decltype(bag.get_ref()), F, Dims...>{bag.get_ref(), f};
+}
+
+template<IsTraverser T, bool WriteBack, class Bag, class F, auto ...Dims>
+inline void operator|(const T &t, const helpers::pack_tile_t<WriteBack, Bag, F, Dims...> &p) {
+	using bag_struct = decltype(p.bag.structure());
+	using value_type = scalar_t<bag_struct>;
+	using bag_dims = typename helpers::auto_order_sig_dims<typename bag_struct::signature>::type;
+	static_assert(std::is_trivially_copyable_v<value_type>, "The elements of the packed bag must be trivially copyable");
+	static_assert(bag_dims::size == sizeof...(Dims) && (... && bag_dims::template contains<Dims>), "All the dimensions of the bag (and no others) have to be packed");
+
+	std::array<std::size_t, sizeof...(Dims)> origins = {};
+	std::array<std::size_t, sizeof...(Dims)> lengths = {};
+	helpers::pack_tile_corners<traversal_dims<T>>::get(t, empty_state, empty_state, [&](auto first, auto last) {
+		const auto first_bag = state_at<decltype(t.get_struct())>(t.top_struct(), first);
+		const auto last_bag = state_at<decltype(t.get_struct())>(t.top_struct(), last);
+		std::size_t i = 0;
+		(..., (origins[i] = std::min<std::size_t>(get_index<Dims>(first_bag), get_index<Dims>(last_bag)),
+			lengths[i] = std::max<std::size_t>(get_index<Dims>(first_bag), get_index<Dims>(last_bag)) - origins[i] + 1, i++));
+	});
+
+	const auto buffer_struct = [&]<std::size_t ...I>(std::index_sequence<I...>) {
+		return scalar<value_type>() ^ vectors<Dims...>(lengths[I]...);
+	}(std::index_sequence_for<decltype(Dims)...>());
+	const auto tile = [&]<std::size_t ...I>(std::index_sequence<I...>) {
+		return p.bag.get_ref() ^ (... ^ slice<Dims>(origins[I], lengths[I]));
+	}(std::index_sequence_for<decltype(Dims)...>());
+
+	const helpers::pack_tile_buffer storage(buffer_struct | get_size());
+	const auto buffer = make_bag(buffer_struct, storage.get());
+	traverser(buffer, tile) | [&](auto state) { buffer[state] = tile[state]; };
+
+	if constexpr (WriteBack) {
+		p.f(packed_tile_t<decltype(buffer), Dims...>{buffer, origins}, t);
+		traverser(tile, buffer) | [&](auto state) { tile[state] = buffer[state]; };
+	} else {
+		const auto read_only = make_bag(buffer_struct, static_cast<const void *>(buffer.data()));
+		p.f(packed_tile_t<decltype(read_only), Dims...>{read_only, origins}, t);
+	}
+}
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_PACK_TILE_HPP
@@ -0,0 +1,155 @@
+#ifndef NOARR_STRUCTURES_PEEL_HPP
+#define NOARR_STRUCTURES_PEEL_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include "../base/contain.hpp"
+#include "../base/state.hpp"
+#include "../base/utility.hpp"
+#include "../structs/slice.hpp"
+#include "../extra/traverser.hpp"
+
+namespace noarr {
+
+/**
+ * @brief identifies the part of a peeled dimension a traversal body is executed for
+ */
+enum class peel_region { front, body, back };
+
+template<peel_region Region>
+using peel_region_t = std::integral_constant<peel_region, Region>;
+
+namespace helpers {
+
+template<class Peel, class F>
+struct peel_for_each_t {
+	Peel peel;
+	F f;
+};
+
+template<class Peel, class F, auto ...Dims> requires IsDimPack<decltype(Dims)...>
+struct peel_for_dims_t {
+	Peel peel;
+	F f;
+};
+
+} // namespace helpers
+
+/**
+ * @brief splits the index range of a dimension into a prologue (the first `front_length()` indices),
+ * a steady state (the body) and an epilogue (the last `back_length()` indices); each part is traversed separately
+ * and the traversal body receives the region as a compile-time constant (see `peel_region_t`)
+ *
+ * If the dimension is shorter than `front_length() + back_length()`, the front is taken first and the rest is left to the back.
+ *
+ * @tparam Dim: the peeled dimension
+ */
+template<IsDim auto Dim, class FrontT, class BackT>
+struct peel_t : strict_contain<FrontT, BackT> {
+	using strict_contain<FrontT, BackT>::strict_contain;
+
+	constexpr FrontT front_length() const noexcept { return this->template get<0>(); }
+	constexpr BackT back_length() const noexcept { return this->template get<1>(); }
+
+	/**
+	 * @brief returns the traverser restricted to the front region
+	 */
+	template<IsTraverser T>
+	constexpr auto front(const T &t) const noexcept {
+		const auto [front_len, back_len, len] = lengths(t);
+		return t ^ slice<Dim>(std::size_t(0), front_len);
+	}
+
+	/**
+	 * @brief returns the traverser restricted to the body (the indices not covered by the front or the back)
+	 */
+	template<IsTraverser T>
+	constexpr auto body(const T &t) const noexcept {
+		const auto [front_len, back_len, len] = lengths(t);
+		return t ^ slice<Dim>(front_len, len - front_len - back_len);
+	}
+
+	/**
+	 * @brief returns the traverser restricted to the back region
+	 */
+	template<IsTraverser T>
+	constexpr auto back(const T &t) const noexcept {
+		const auto [front_len, back_len, len] = lengths(t);
+		return t ^ slice<Dim>(len - back_len, back_len);
+	}
+
+	/**
+	 * @brief traverses all the dimensions of `t` (the peeled one has to be the outermost), calling `f(state, region)`
+	 */
+	template<IsTraverser T, class F>
+	constexpr void for_each(const T &t, F f) const {
+		using signature = typename decltype(t.top_struct())::signature;
+		static_assert(signature::dim == Dim, "The peeled dimension has to be the outermost dimension of the traversal");
+
+		front(t).for_each([f](auto state) constexpr { f(state, peel_region_t<peel_region::front>()); });
+		body(t).for_each([f](auto state) constexpr { f(state, peel_region_t<peel_region::body>()); });
+		back(t).for_each([f](auto state) constexpr { f(state, peel_region_t<peel_region::back>()); });
+	}
+
+	/**
+	 * @brief traverses the dimensions `Dims` of `t` (the peeled one has to be the first of them), calling `f(inner, region)`
+	 */
+	template<auto D, auto ...Dims, IsTraverser T, class F> requires IsDim<decltype(D)> && IsDimPack<decltype(Dims)...>
+	constexpr void for_dims(const T &t, F f) const {
+		static_assert(D == Dim, "The peeled dimension has to be the first of the traversed dimensions");
+
+		front(t).template for_dims<D, Dims...>([f](auto inner) constexpr { f(inner, peel_region_t<peel_region::front>()); });
+		body(t).template for_dims<D, Dims...>([f](auto inner) constexpr { f(inner, peel_region_t<peel_region::body>()); });
+		back(t).template for_dims<D, Dims...>([f](auto inner) constexpr { f(inner, peel_region_t<peel_region::back>()); });
+	}
+
+	/**
+	 * @brief creates an object that traverses all the dimensions of a traverser it is applied to (via `|`), see `for_each` above
+	 */
+	template<class F>
+	constexpr auto for_each(F f) const noexcept {
+		return helpers::peel_for_each_t<peel_t, F>{*this, f};
+	}
+
+	/**
+	 * @brief creates an object that traverses the dimensions `Dims` of a traverser it is applied to (via `|`), see `for_dims` above
+	 */
+	template<auto ...Dims, class F> requires IsDimPack<decltype(Dims)...>
+	constexpr auto for_dims(F f) const noexcept {
+		return helpers::peel_for_dims_t<peel_t, F, Dims...>{*this, f};
+	}
+
+private:
+	struct split_lengths {
+		std::size_t front, back, total;
+	};
+
+	template<IsTraverser T>
+	constexpr split_lengths lengths(const T &t) const noexcept {
+		const std::size_t len = t.top_struct().template length<Dim>(empty_state);
+		const std::size_t front_len = front_length() < len ? std::size_t(front_length()) : len;
+		const std::size_t back_len = back_length() < len - front_len ? std::size_t(back_length()) : len - front_len;
+		return {front_len, back_len, len};
+	}
+};
+
+/**
+ * @brief peels the first `front` and the last `back` indices of the dimension `Dim` off the traversal (see `peel_t`)
+ */
+template<IsDim auto Dim, class FrontT, class BackT>
+constexpr auto peel(FrontT front, BackT back) noexcept { return peel_t<Dim, good_index_t<FrontT>, good_index_t<BackT>>(front, back); }
+
+template<IsTraverser T, class Peel, class F>
+constexpr void operator|(const T &t, const helpers::peel_for_each_t<Peel, F> &p) {
+	p.peel.for_each(t, p.f);
+}
+
+template<IsTraverser T, class Peel, class F, auto ...Dims>
+constexpr void operator|(const T &t, const helpers::peel_for_dims_t<Peel, F, Dims...> &p) {
+	p.peel.template for_dims<Dims...>(t, p.f);
+}
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_PEEL_HPP
@@ -336,8 +336,9 @@ private:
 			if constexpr(dim_sig::dependent) {
 				for_each_impl_dep<Dim, Branches...>(state, std::index_sequence_for<Branches...>());
 			} else {
-				std::size_t len = top_struct().template length<Dim>(state);
-				for(std::size_t i = 0; i < len; i++)
+				const auto len = top_struct().template length<Dim>(state);
+				using index_t = good_index_t<decltype(+len)>;
+				for(index_t i = 0; i < len; i++)
 					for_each_impl(Branches()..., state.template with<index_in<Dim>>(i));
 			}
 		}
@@ -0,0 +1,161 @@
+#ifndef NOARR_STRUCTURES_RECURSIVE_BISECT_HPP
+#define NOARR_STRUCTURES_RECURSIVE_BISECT_HPP
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include "../base/contain.hpp"
+#include "../base/state.hpp"
+#include "../base/utility.hpp"
+#include "../structs/slice.hpp"
+#include "../extra/traverser.hpp"
+
+namespace noarr {
+
+namespace helpers {
+
+template<class Bisect, class F>
+struct bisect_for_each_t {
+	Bisect bisect;
+	F f;
+};
+
+template<class Bisect, class F>
+struct bisect_for_tiles_t {
+	Bisect bisect;
+	F f;
+};
+
+} // namespace helpers
+
+/**
+ * @brief a cache-oblivious traversal order: the index space of the dimensions `Dims` is recursively halved
+ * along its longest dimension until no dimension of the tile is longer than `leaf_length()`;
+ * the tiles (leaves) are then traversed in the order of the recursion, each of them in the order of the original traverser
+ *
+ * The halves are always visited in the increasing order of indices, so the relative order of any two iterations
+ * that differ in a single dimension is preserved (e.g. a reduction along one of `Dims` is accumulated in the original order).
+ *
+ * @tparam Dims: the bisected dimensions (their lengths must not depend on each other)
+ */
+template<class LeafT, auto ...Dims> requires IsDimPack<decltype(Dims)...>
+struct recursive_bisect_t : strict_contain<LeafT> {
+	using strict_contain<LeafT>::strict_contain;
+
+	static_assert(sizeof...(Dims) > 0, "At least one dimension has to be bisected");
+
+	using box = std::array<std::size_t, sizeof...(Dims)>;
+
+	constexpr LeafT leaf_length() const noexcept { return this->get(); }
+
+	/**
+	 * @brief returns the lengths of the bisected dimensions in the traverser `t`
+	 */
+	template<IsTraverser T>
+	constexpr box lengths(const T &t) const noexcept {
+		return box{std::size_t(t.top_struct().template length<Dims>(empty_state))...};
+	}
+
+	/**
+	 * @brief returns the index of the dimension to be halved in a tile of the lengths `len`, or `sizeof...(Dims)` if the tile is a leaf
+	 */
+	constexpr std::size_t split_dim(const box &len) const noexcept {
+		std::size_t longest = 0;
+		for (std::size_t i = 1; i < sizeof...(Dims); i++)
+			if (len[i] > len[longest])
+				longest = i;
+		return len[longest] > std::size_t(leaf_length()) ? longest : sizeof...(Dims);
+	}
+
+	/**
+	 * @brief returns the traverser `t` restricted to the tile starting at `lo` with the lengths `len`
+	 */
+	template<IsTraverser T>
+	constexpr auto tile(const T &t, const box &lo, const box &len) const noexcept {
+		return [&]<std::size_t ...I>(std::index_sequence<I...>) {
+			return (t ^ ... ^ slice<Dims>(lo[I], len[I]));
+		}(std::make_index_sequence<sizeof...(Dims)>());
+	}
+
+	/**
+	 * @brief calls `f(tile)` for each leaf tile of `t` (see `tile`), in the order of the recursion
+	 */
+	template<IsTraverser T, class F>
+	constexpr void for_tiles(const T &t, F f) const {
+		recurse(t, box{}, lengths(t), f);
+	}
+
+	/**
+	 * @brief traverses all the dimensions of `t` in the recursive-bisection order, calling `f(state)`
+	 */
+	template<IsTraverser T, class F>
+	constexpr void for_each(const T &t, F f) const {
+		for_tiles(t, [&f](const auto &tile) { tile.for_each(f); });
+	}
+
+	/**
+	 * @brief creates an object that traverses all the dimensions of a traverser it is applied to (via `|`), see `for_each` above
+	 */
+	template<class F>
+	constexpr auto for_each(F f) const noexcept {
+		return helpers::bisect_for_each_t<recursive_bisect_t, F>{*this, f};
+	}
+
+	/**
+	 * @brief creates an object that calls `f(tile)` for each leaf tile of a traverser it is applied to (via `|`), see `for_tiles` above
+	 */
+	template<class F>
+	constexpr auto for_tiles(F f) const noexcept {
+		return helpers::bisect_for_tiles_t<recursive_bisect_t, F>{*this, f};
+	}
+
+	/**
+	 * @brief halves the tile (`lo`, `len`) along the dimension `dim` (see `split_dim`), returning the upper half and shrinking `len` to the lower one
+	 */
+	static constexpr std::pair<box, box> split(std::size_t dim, box lo, box &len) noexcept {
+		const std::size_t half = len[dim] / 2;
+		box hi_len = len;
+		len[dim] = half;
+		lo[dim] += half;
+		hi_len[dim] -= half;
+		return {lo, hi_len};
+	}
+
+private:
+	template<IsTraverser T, class F>
+	constexpr void recurse(const T &t, box lo, box len, F &f) const {
+		const std::size_t dim = split_dim(len);
+		if (dim == sizeof...(Dims)) {
+			f(tile(t, lo, len));
+			return;
+		}
+
+		const auto [hi_lo, hi_len] = split(dim, lo, len);
+		recurse(t, lo, len, f);
+		recurse(t, hi_lo, hi_len, f);
+	}
+};
+
+/**
+ * @brief traverses the dimensions `Dims` in a cache-oblivious order, recursively halving the longest one
+ * down to tiles no longer than `leaf_length` in any of them (see `recursive_bisect_t`)
+ *
+ * Unlike `merge_zcurve`, this only changes the order of the traversal, not the layout of the data, and it places no requirements on the lengths.
+ */
+template<auto ...Dims, class LeafT> requires IsDimPack<decltype(Dims)...>
+constexpr auto recursive_bisect(LeafT leaf_length) noexcept { return recursive_bisect_t<good_index_t<LeafT>, Dims...>(leaf_length); }
+
+template<IsTraverser T, class Bisect, class F>
+constexpr void operator|(const T &t, const helpers::bisect_for_each_t<Bisect, F> &b) {
+	b.bisect.for_each(t, b.f);
+}
+
+template<IsTraverser T, class Bisect, class F>
+constexpr void operator|(const T &t, const helpers::bisect_for_tiles_t<Bisect, F> &b) {
+	b.bisect.for_tiles(t, b.f);
+}
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_RECURSIVE_BISECT_HPP
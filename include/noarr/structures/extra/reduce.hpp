@@ -0,0 +1,105 @@
+#ifndef NOARR_STRUCTURES_REDUCE_HPP
+#define NOARR_STRUCTURES_REDUCE_HPP
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#include "../base/utility.hpp"
+#include "../structs/slice.hpp"
+#include "../extra/traverser.hpp"
+
+namespace noarr {
+
+namespace helpers {
+
+template<auto Dim, std::size_t Accumulators, class T, class Op, class Body> requires IsDim<decltype(Dim)>
+struct reduce_t {
+	T init;
+	T neutral;
+	Op op;
+	Body body;
+
+	static_assert(Accumulators > 0, "At least one accumulator is needed");
+
+	// combines the accumulators [Begin, End) pairwise (as a balanced tree)
+	template<std::size_t Begin, std::size_t End>
+	constexpr T combine(const std::array<T, Accumulators> &acc) const {
+		if constexpr (End - Begin == 1) {
+			return acc[Begin];
+		} else {
+			constexpr std::size_t mid = Begin + (End - Begin) / 2;
+			return op(combine<Begin, mid>(acc), combine<mid, End>(acc));
+		}
+	}
+
+	template<IsTraverser Traverser>
+	constexpr T operator()(const Traverser &t) const {
+		using signature = typename decltype(t.top_struct())::signature;
+		static_assert(signature::template any_accept<Dim>, "The traversal does not have the reduced dimension");
+
+		std::array<T, Accumulators> acc;
+		acc.fill(neutral);
+
+		const auto accumulate = [this, &t](T &a, std::size_t i) {
+			(t ^ fix<Dim>(i)).for_each([this, &a](auto state) { a = op(a, body(state)); });
+		};
+
+		const std::size_t length = t.top_struct().template length<Dim>(empty_state);
+		const std::size_t full = length - length % Accumulators;
+
+		for (std::size_t i = 0; i < full; i += Accumulators) {
+			[&]<std::size_t ...L>(std::index_sequence<L...>) {
+				(..., accumulate(acc[L], i + L));
+			}(std::make_index_sequence<Accumulators>());
+		}
+
+		for (std::size_t i = full; i < length; i++)
+			accumulate(acc[i - full], i);
+
+		return op(init, combine<0, Accumulators>(acc));
+	}
+};
+
+} // namespace helpers
+
+/**
+ * @brief reduces the values returned by `body(state)` for all the states of a traverser it is applied to (via `|`) using `op`,
+ * starting from `init`; the value of the reduction is returned
+ *
+ * The indices of the dimension `Dim` are distributed among `Accumulators` independent accumulators
+ * (index `i` goes to the accumulator `i % Accumulators`), which are combined pairwise at the end. This breaks the dependence chain
+ * through a single accumulator (and lets the compiler keep the accumulators in vector lanes), so `op` has to be associative
+ * and commutative (for floating-point numbers, the result may differ from a sequential reduction in rounding).
+ *
+ * Each accumulator walks all the other dimensions of the traversal with its index of `Dim` fixed. `Dim` should thus be
+ * the innermost dimension of the traversal (reduce the inner sections, e.g. from `for_dims` over the outer dimensions)
+ * or a dimension whose slices are contiguous; otherwise, the accumulators walk the memory in a strided order.
+ *
+ * @tparam Dim: the dimension whose indices are distributed among the accumulators
+ * @tparam Accumulators: the number of independent accumulators
+ * @param init: the initial value of the reduction, it is combined with the result exactly once
+ * @param neutral: the initial value of each accumulator, it has to be neutral for `op` (e.g. the lowest value for a maximum)
+ */
+template<auto Dim, std::size_t Accumulators = 4, class T, class Op, class Body> requires IsDim<decltype(Dim)>
+constexpr auto reduce(T init, T neutral, Op op, Body body) noexcept {
+	return helpers::reduce_t<Dim, Accumulators, T, Op, Body>{init, neutral, op, body};
+}
+
+/**
+ * @brief adds the values returned by `body(state)` to `init` (see `reduce` above)
+ */
+template<auto Dim, std::size_t Accumulators = 4, class T, class Body> requires IsDim<decltype(Dim)>
+constexpr auto reduce(T init, Body body) noexcept {
+	return helpers::reduce_t<Dim, Accumulators, T, std::plus<T>, Body>{init, T(), std::plus<T>(), body};
+}
+
+template<IsTraverser Traverser, auto Dim, std::size_t Accumulators, class T, class Op, class Body>
+constexpr T operator|(const Traverser &t, const helpers::reduce_t<Dim, Accumulators, T, Op, Body> &r) {
+	return r(t);
+}
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_REDUCE_HPP
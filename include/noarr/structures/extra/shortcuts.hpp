@@ -2,6 +2,7 @@
 #define NOARR_STRUCTURES_SHORTCUTS_HPP
 
 #include <cstddef>
+#include <cstdint>
 
 #include "../base/state.hpp"
 #include "../base/structs_common.hpp"
@@ -126,6 +127,47 @@ constexpr auto strip_mine_dynamic(auto ...optional_minor_length) noexcept {
 	return into_blocks_dynamic<Dim, DimMajor, DimMinor, DimIsPresent>(optional_minor_length...) ^ hoist<DimMajor>();
 }
 
+template<IsDim auto Dim, IsDim auto DimMajor, IsDim auto DimMinor = Dim>
+constexpr auto strip_mine_clamped(auto minor_length) noexcept {
+	return into_blocks_clamped<Dim, DimMajor, DimMinor>(minor_length) ^ hoist<DimMajor>();
+}
+
+namespace helpers {
+
+template<auto Dim, char Role>
+struct derived_dim_tag {
+	constexpr bool operator==(const derived_dim_tag &) const noexcept = default;
+};
+
+} // namespace helpers
+
+/**
+ * @brief a dimension name derived from `Dim`, used for the auxiliary dimensions created by compositions (e.g. tile indices)
+ */
+template<auto Dim, char Role>
+constexpr dim<helpers::derived_dim_tag<Dim, Role>{}> derived_dim;
+
+/**
+ * @brief 2.5D blocking: tiles the dimensions `DimI` and `DimJ` (into `block_i` x `block_j` tiles indexed by `DimIMajor` and `DimJMajor`)
+ * and streams along `DimK` within each tile, so that the neighbouring planes of the tile stay in cache
+ */
+template<IsDim auto DimI, IsDim auto DimJ, IsDim auto DimK, IsDim auto DimIMajor = derived_dim<DimI, 'M'>, IsDim auto DimJMajor = derived_dim<DimJ, 'M'>>
+constexpr auto blocking_2_5d(auto block_i, auto block_j) noexcept {
+	return into_blocks_clamped<DimI, DimIMajor>(block_i) ^
+		into_blocks_clamped<DimJ, DimJMajor>(block_j) ^
+		hoist<DimK>() ^ hoist<DimJMajor>() ^ hoist<DimIMajor>();
+}
+
+/**
+ * @brief 2.5D blocking (see `blocking_2_5d`) with the tile indices merged into the outermost dimension `DimTile`,
+ * so that parallel executors (e.g. `tbb_for_each`, `omp_for_each`) distribute the tiles across threads
+ */
+template<IsDim auto DimI, IsDim auto DimJ, IsDim auto DimK, IsDim auto DimTile = derived_dim<DimI, 'T'>>
+constexpr auto blocking_2_5d_tiles(auto block_i, auto block_j) noexcept {
+	return blocking_2_5d<DimI, DimJ, DimK, derived_dim<DimI, 'M'>, derived_dim<DimJ, 'M'>>(block_i, block_j) ^
+		merge_blocks<derived_dim<DimI, 'M'>, derived_dim<DimJ, 'M'>, DimTile>();
+}
+
 template<auto ...Dims, class ...Lengths>
 constexpr auto bcast(Lengths ...lengths) noexcept requires (sizeof...(Dims) == sizeof...(Lengths)) && IsDimPack<decltype(Dims)...> {
 	return (... ^ (bcast<Dims>() ^ set_length<Dims>(lengths)));
@@ -159,7 +201,7 @@ template<auto ...Dims, IsState State, class ...Diffs> requires (sizeof...(Dims)
 constexpr auto neighbor(State state, Diffs ...diffs) noexcept {
 	using namespace noarr::constexpr_arithmetic;
 	static_assert((... && State::template contains<index_in<Dims>>), "Requested dimension does not exist");
-	static_assert((... && std::is_same_v<state_get_t<State, index_in<Dims>>, std::size_t>), "Cannot shift in a dimension that is not dynamic");
+	static_assert((... && (std::is_same_v<state_get_t<State, index_in<Dims>>, std::size_t> || std::is_same_v<state_get_t<State, index_in<Dims>>, std::uint32_t>)), "Cannot shift in a dimension that is not dynamic");
 	return state.template with<index_in<Dims>...>(good_diff_index_t<decltype(state.template get<index_in<Dims>>() + diffs)>(state.template get<index_in<Dims>>() + diffs)...);
 }
 
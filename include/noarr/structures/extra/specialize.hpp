@@ -0,0 +1,83 @@
+#ifndef NOARR_STRUCTURES_SPECIALIZE_HPP
+#define NOARR_STRUCTURES_SPECIALIZE_HPP
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../base/utility.hpp"
+#include "../structs/setters.hpp"
+
+namespace noarr {
+
+/**
+ * @brief the lengths for which `specialize` instantiates a kernel with static lengths
+ */
+template<std::size_t ...Lengths>
+struct candidates_t {};
+
+template<std::size_t ...Lengths>
+constexpr candidates_t<Lengths...> candidates;
+
+namespace helpers {
+
+template<auto Dim>
+using specialize_dynamic_length = std::size_t;
+
+template<class Candidates, auto ...Dims>
+struct specialize_impl {
+	static constexpr std::size_t num_dims = sizeof...(Dims);
+
+	// the fallback: all the lengths are dynamic
+	template<class F>
+	using result = std::invoke_result_t<F &, decltype(set_length<Dims...>(specialize_dynamic_length<Dims>()...))>;
+
+	template<class F, class ...Lens>
+	static constexpr result<F> dispatch(const std::array<std::size_t, num_dims> &lengths, F &f, Lens ...lens) {
+		if constexpr (sizeof...(Lens) == num_dims)
+			return f(set_length<Dims...>(lens...));
+		else
+			return match(lengths, f, Candidates(), lens...);
+	}
+
+	// matches the length of the next dimension (the `sizeof...(Lens)`-th one) against the candidates
+	template<class F, std::size_t Candidate, std::size_t ...Rest, class ...Lens>
+	static constexpr result<F> match(const std::array<std::size_t, num_dims> &lengths, F &f, candidates_t<Candidate, Rest...>, Lens ...lens) {
+		if (lengths[sizeof...(Lens)] == Candidate)
+			return dispatch(lengths, f, lens..., lit<Candidate>);
+		return match(lengths, f, candidates_t<Rest...>(), lens...);
+	}
+
+	template<class F, class ...Lens>
+	static constexpr result<F> match(const std::array<std::size_t, num_dims> &lengths, F &f, candidates_t<>, Lens ...lens) {
+		return dispatch(lengths, f, lens..., lengths[sizeof...(Lens)]);
+	}
+};
+
+} // namespace helpers
+
+/**
+ * @brief calls `f(lengths)`, where `lengths` is a proto-structure setting the lengths of the dimensions `Dims`
+ * (as in `set_length<Dims...>(...)`) to `runtime_lengths`; each length that matches a candidate is set as `lit<Candidate>`
+ * (a static length, enabling the compile-time optimizations of the structures), the other lengths stay dynamic
+ *
+ * `f` is instantiated for each combination of the candidates and the dynamic length (over all the dimensions),
+ * so the number of candidates should be kept small. All the instantiations have to return the same type
+ * (the one returned for the dynamic lengths).
+ *
+ * @tparam Dims: the dimensions whose lengths are set
+ * @param runtime_lengths: the lengths of the dimensions, in the order of `Dims`
+ * @param candidates: the lengths to be specialized for (see `candidates`)
+ * @param f: the kernel, typically a generic lambda applying `lengths` to its structures (e.g. `scalar<float>() ^ vectors<'j', 'i'>() ^ lengths`)
+ */
+template<auto ...Dims, std::size_t ...Candidates, class F> requires IsDimPack<decltype(Dims)...>
+constexpr decltype(auto) specialize(const std::array<std::size_t, sizeof...(Dims)> &runtime_lengths, candidates_t<Candidates...>, F f) {
+	static_assert(sizeof...(Dims) > 0, "At least one dimension has to be specialized");
+	return helpers::specialize_impl<candidates_t<Candidates...>, Dims...>::dispatch(runtime_lengths, f);
+}
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_SPECIALIZE_HPP
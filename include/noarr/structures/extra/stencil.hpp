@@ -0,0 +1,173 @@
+#ifndef NOARR_STRUCTURES_STENCIL_HPP
+#define NOARR_STRUCTURES_STENCIL_HPP
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "../base/state.hpp"
+#include "../base/utility.hpp"
+#include "../extra/funcs.hpp"
+#include "../interop/bag.hpp"
+
+namespace noarr {
+
+namespace helpers {
+
+// the coefficient type of a stencil that only sums up the neighbours
+struct stencil_no_coeffs {};
+
+template<class T>
+constexpr T *stencil_neighbor(T *ptr, std::ptrdiff_t off) noexcept {
+	using byte = std::conditional_t<std::is_const_v<T>, const char, char>;
+	return (T*) ((byte*) ptr + off);
+}
+
+} // namespace helpers
+
+/**
+ * @brief a stencil bound to a bag; the relative byte offsets of all the points are computed once (in `stencil_t::bind`)
+ * and each evaluation then costs a single offset computation (of the central element) plus pointer arithmetic
+ *
+ * @tparam Bag: the (non-owning) bag the stencil reads from
+ * @tparam N: the number of points in the stencil
+ * @tparam Coeff: the type of the weights
+ */
+template<class Bag, std::size_t N, class Coeff>
+struct bound_stencil_t {
+	Bag bag;
+	std::array<std::ptrdiff_t, N> offsets;
+	std::array<Coeff, N> coeffs;
+
+	/**
+	 * @brief returns a reference to the `K`-th point of the stencil centered at `state`
+	 */
+	template<std::size_t K>
+	constexpr decltype(auto) get(IsState auto state) const noexcept {
+		static_assert(K < N, "Stencil point index out of range");
+		return *helpers::stencil_neighbor(&bag[state], offsets[K]);
+	}
+
+	/**
+	 * @brief applies `f` to the values of all the points (in the order they were specified) of the stencil centered at `state`
+	 */
+	template<IsState State, class F>
+	constexpr decltype(auto) combine(State state, F f) const noexcept {
+		const auto center = &bag[state];
+		return [=, this]<std::size_t ...K>(std::index_sequence<K...>) -> decltype(auto) {
+			return f(*helpers::stencil_neighbor(center, offsets[K])...);
+		}(std::make_index_sequence<N>());
+	}
+
+	/**
+	 * @brief returns the (weighted, if the stencil has coefficients) sum of the points of the stencil centered at `state`,
+	 * the additions are performed from left to right in the order the points were specified
+	 */
+	template<IsState State>
+	constexpr auto sum(State state) const noexcept {
+		const auto center = &bag[state];
+		return [=, this]<std::size_t ...K>(std::index_sequence<K...>) {
+			if constexpr (std::is_same_v<Coeff, helpers::stencil_no_coeffs>)
+				return (... + *helpers::stencil_neighbor(center, offsets[K]));
+			else
+				return (... + (coeffs[K] * *helpers::stencil_neighbor(center, offsets[K])));
+		}(std::make_index_sequence<N>());
+	}
+
+	constexpr auto operator()(IsState auto state) const noexcept {
+		return sum(state);
+	}
+};
+
+/**
+ * @brief describes a stencil: a set of points (displacements from the central element) in the dimensions `Dims`,
+ * optionally each with a coefficient (weight)
+ *
+ * @tparam N: the number of points in the stencil
+ * @tparam Coeff: the type of the weights (`helpers::stencil_no_coeffs` if there are none)
+ * @tparam Dims: the dimensions in which the displacements are specified
+ */
+template<std::size_t N, class Coeff, auto ...Dims> requires IsDimPack<decltype(Dims)...>
+struct stencil_t {
+	using point = std::array<std::ptrdiff_t, sizeof...(Dims)>;
+
+	std::array<point, N> points;
+	std::array<Coeff, N> coeffs;
+
+	/**
+	 * @brief returns the number of indices the stencil reaches below the central element in the `I`-th dimension
+	 */
+	template<std::size_t I>
+	constexpr std::size_t radius_before() const noexcept {
+		std::ptrdiff_t radius = 0;
+		for (const auto &p : points)
+			if (-p[I] > radius)
+				radius = -p[I];
+		return radius;
+	}
+
+	/**
+	 * @brief binds the stencil to a bag, computing the relative offsets of all the points
+	 *
+	 * @param bag: the bag the stencil reads from (only a reference to its data is kept)
+	 * @param base: indices of the dimensions of the bag other than `Dims` (their values do not matter for affine layouts)
+	 */
+	template<class Bag, IsState State = state<>>
+	constexpr auto bind(const Bag &bag, State base = empty_state) const noexcept {
+		const auto ref = bag.get_ref();
+		const auto structure = ref.structure();
+
+		return [&]<std::size_t ...I>(std::index_sequence<I...>) {
+			const auto origin = base.template with<index_in<Dims>...>(radius_before<I>()...);
+			const auto origin_offset = (std::ptrdiff_t)(structure | offset(origin));
+
+			std::array<std::ptrdiff_t, N> offsets;
+			for (std::size_t k = 0; k < N; k++) {
+				const auto at = base.template with<index_in<Dims>...>((std::size_t)((std::ptrdiff_t)radius_before<I>() + points[k][I])...);
+				offsets[k] = (std::ptrdiff_t)(structure | offset(at)) - origin_offset;
+			}
+
+			return bound_stencil_t<decltype(ref), N, Coeff>{ref, offsets, coeffs};
+		}(std::make_index_sequence<sizeof...(Dims)>());
+	}
+};
+
+/**
+ * @brief creates a stencil from a list of points (displacements from the central element in the dimensions `Dims`);
+ * the evaluation (see `bound_stencil_t::sum`) sums up the points
+ *
+ * @tparam Dims: the dimensions in which the displacements are specified
+ * @param points: the displacements, e.g. `{{0, 0}, {0, 1}, {0, -1}, {1, 0}, {-1, 0}}` for a five-point stencil
+ */
+template<auto ...Dims, std::size_t N> requires IsDimPack<decltype(Dims)...>
+constexpr auto stencil(const std::ptrdiff_t (&points)[N][sizeof...(Dims)]) noexcept {
+	stencil_t<N, helpers::stencil_no_coeffs, Dims...> s{};
+	for (std::size_t k = 0; k < N; k++)
+		for (std::size_t i = 0; i < sizeof...(Dims); i++)
+			s.points[k][i] = points[k][i];
+	return s;
+}
+
+/**
+ * @brief creates a stencil from a list of points (displacements from the central element in the dimensions `Dims`)
+ * and their coefficients; the evaluation (see `bound_stencil_t::sum`) computes the weighted sum of the points
+ *
+ * @tparam Dims: the dimensions in which the displacements are specified
+ * @param points: the displacements, e.g. `{{0, 0}, {0, 1}, {0, -1}, {1, 0}, {-1, 0}}` for a five-point stencil
+ * @param coeffs: the coefficients of the points
+ */
+template<auto ...Dims, std::size_t N, class Coeff> requires IsDimPack<decltype(Dims)...>
+constexpr auto stencil(const std::ptrdiff_t (&points)[N][sizeof...(Dims)], const Coeff (&coeffs)[N]) noexcept {
+	stencil_t<N, Coeff, Dims...> s{};
+	for (std::size_t k = 0; k < N; k++) {
+		for (std::size_t i = 0; i < sizeof...(Dims); i++)
+			s.points[k][i] = points[k][i];
+		s.coeffs[k] = coeffs[k];
+	}
+	return s;
+}
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_STENCIL_HPP
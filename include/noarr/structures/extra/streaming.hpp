@@ -0,0 +1,273 @@
+#ifndef NOARR_STRUCTURES_STREAMING_HPP
+#define NOARR_STRUCTURES_STREAMING_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "../base/contain.hpp"
+#include "../base/state.hpp"
+#include "../extra/auto_order.hpp"
+#include "../extra/struct_traits.hpp"
+#include "../extra/to_struct.hpp"
+#include "../extra/traverser.hpp"
+#include "../interop/bag.hpp"
+#include "../interop/traverser_iter.hpp"
+
+namespace noarr {
+
+/**
+ * @brief orders the preceding non-temporal stores (see `streaming`) before the following stores (`sfence`)
+ */
+inline void stream_fence() noexcept {
+#if defined(__SSE2__)
+	_mm_sfence();
+#endif
+}
+
+/**
+ * @brief the part of a thread in which it may write to `streaming` bags: the non-temporal stores are fenced (`stream_fence`)
+ * when the (outermost) scope is left, also by an exception
+ *
+ * `streamed` and `stream_into` open the scope themselves; a thread writing to a `streaming` bag otherwise
+ * (e.g. a worker of a parallel traversal) has to open its own. The writes outside a scope fail an assertion.
+ */
+class stream_scope {
+	static std::size_t &depth() noexcept {
+		constinit thread_local std::size_t depth = 0;
+		return depth;
+	}
+
+public:
+	stream_scope() noexcept { depth()++; }
+	~stream_scope() {
+		if (--depth() == 0)
+			stream_fence();
+	}
+
+	stream_scope(const stream_scope &) = delete;
+	stream_scope &operator=(const stream_scope &) = delete;
+
+	// whether the current thread is in a scope
+	static bool active() noexcept { return depth() != 0; }
+};
+
+namespace helpers {
+
+// the width of the non-temporal vector stores (in bytes)
+#if defined(__AVX512F__)
+constexpr std::size_t stream_vector_bytes = 64;
+#elif defined(__AVX__)
+constexpr std::size_t stream_vector_bytes = 32;
+#else
+constexpr std::size_t stream_vector_bytes = 16;
+#endif
+
+// stores `value` to `ptr` bypassing the caches (`movnti`) if the type has a size of a general-purpose register, otherwise it is an ordinary store
+template<class T>
+inline void stream_store(T *ptr, T value) noexcept {
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#if defined(__x86_64__)
+	constexpr bool register_sized = sizeof(T) == sizeof(std::uint32_t) || sizeof(T) == sizeof(std::uint64_t);
+#else
+	constexpr bool register_sized = sizeof(T) == sizeof(std::uint32_t);
+#endif
+	if constexpr (register_sized && std::is_trivially_copyable_v<T>) {
+		// the bits of the value are copied into the register operand, the memory operand is the element itself (not punned to an integer)
+		std::conditional_t<sizeof(T) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t> bits;
+		__builtin_memcpy(&bits, &value, sizeof(bits));
+		asm volatile("movnti %1, %0" : "=m"(*ptr) : "r"(bits));
+		return;
+	}
+#endif
+	*ptr = value;
+}
+
+// copies `n` elements from `src` to `dst` by non-temporal stores: vector stores where `dst` is aligned to the vector width,
+// scalar stores (`stream_store`) for the head before the first aligned element and for the tail
+template<class T>
+inline void stream_copy(T *dst, const T *src, std::size_t n) noexcept {
+	std::size_t i = 0;
+#if defined(__SSE2__)
+	if constexpr (stream_vector_bytes % sizeof(T) == 0) {
+		constexpr std::size_t w = stream_vector_bytes / sizeof(T);
+		for (; i < n && reinterpret_cast<std::uintptr_t>(dst + i) % stream_vector_bytes != 0; i++)
+			stream_store(dst + i, src[i]);
+		for (; i + w <= n; i += w) {
+#if defined(__AVX512F__)
+			_mm512_stream_si512(reinterpret_cast<__m512i *>(dst + i), _mm512_loadu_si512(src + i));
+#elif defined(__AVX__)
+			_mm256_stream_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i)));
+#else
+			_mm_stream_si128(reinterpret_cast<__m128i *>(dst + i), _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)));
+#endif
+		}
+	}
+#endif
+	for (; i < n; i++)
+		stream_store(dst + i, src[i]);
+}
+
+template<class F>
+struct streamed_t {
+	F f;
+};
+
+template<class Bag, class F>
+struct stream_into_t {
+	Bag bag;
+	F f;
+};
+
+// the innermost dimension of a traversal and the others
+template<class Dims>
+struct stream_into_dims;
+
+template<auto Dim>
+struct stream_into_dims<dim_sequence<Dim>> {
+	static constexpr auto inner = Dim;
+	using outer = dim_sequence<>;
+};
+
+template<auto Dim, auto ...Dims> requires (sizeof...(Dims) > 0)
+struct stream_into_dims<dim_sequence<Dim, Dims...>> {
+	static constexpr auto inner = stream_into_dims<dim_sequence<Dims...>>::inner;
+	using outer = typename dim_sequence_concat_impl<dim_sequence<Dim>, typename stream_into_dims<dim_sequence<Dims...>>::outer>::type;
+};
+
+} // namespace helpers
+
+/**
+ * @brief a write-only reference to an element of a `streaming` bag
+ */
+template<class T>
+struct streaming_ref_t {
+	T *ptr;
+
+	template<class U> requires std::is_convertible_v<U, T>
+	const streaming_ref_t &operator=(U &&value) const noexcept {
+		assert(stream_scope::active() && "A streaming bag can only be written in a stream_scope (see streamed)");
+		helpers::stream_store(ptr, T(std::forward<U>(value)));
+		return *this;
+	}
+};
+
+/**
+ * @brief a write-only view of a bag whose elements are written by scalar non-temporal stores, which bypass the caches and do not read
+ * the cache lines before writing them; for large outputs that are not read soon (it is the writes to the consecutive elements,
+ * typically those in the innermost dimension, that are combined into whole cache lines)
+ *
+ * The non-temporal stores are weakly ordered, so the bag can only be written in a `stream_scope`, which fences them when it is left:
+ * a traversal writing it is run through `streamed` (or `stream_into`), a worker thread writing it opens its own scope.
+ * For an output computed element by element, `stream_into` writes the consecutive elements by vector non-temporal stores.
+ */
+template<class Bag>
+struct streaming_bag_t : strict_contain<Bag> {
+	using strict_contain<Bag>::strict_contain;
+
+	constexpr Bag bag() const noexcept { return this->get(); }
+	constexpr auto structure() const noexcept { return bag().structure(); }
+	constexpr auto data() const noexcept { return bag().data(); }
+
+	constexpr auto operator[](ToState auto state) const noexcept {
+		using type = std::remove_reference_t<decltype(bag()[state])>;
+		static_assert(!std::is_const_v<type>, "Cannot stream into a read-only bag");
+		return streaming_ref_t<type>{&bag()[state]};
+	}
+};
+
+/**
+ * @brief returns a write-only view of the bag whose elements are written by non-temporal stores (see `streaming_bag_t`)
+ */
+template<class Bag> requires IsBag<Bag>
+constexpr auto streaming(const Bag &bag) noexcept {
+	return streaming_bag_t<decltype(bag.get_ref())>(bag.get_ref());
+}
+
+/**
+ * @brief applies `f` to the traverser it is applied to (via `|`, `f` is a function or e.g. `for_dims<...>(...)`)
+ * in a `stream_scope`, so that the non-temporal stores to `streaming` bags in `f` are complete when it returns
+ */
+template<class F>
+constexpr auto streamed(F f) noexcept {
+	return helpers::streamed_t<F>{f};
+}
+
+template<IsTraverser T, class F>
+inline void operator|(const T &t, const helpers::streamed_t<F> &s) {
+	const stream_scope scope;
+	t | s.f;
+}
+
+/**
+ * @brief writes `bag[state] = f(state)` for each state of the traversal it is applied to (via `|`) by non-temporal stores:
+ * the values of a run of the innermost dimension of the traversal are computed into a buffer (which keeps `f` vectorizable)
+ * and copied to the bag by vector non-temporal stores (scalar ones at the unaligned ends), the stores are fenced at the end
+ *
+ * The runs are used if the innermost dimension of the traversal is the innermost (contiguous) dimension of the bag
+ * and the order keeps it contiguous and ascending (as for `traverser_t::chunks`); otherwise the elements are stored one by one.
+ * `f` must not read the bag.
+ */
+template<class Bag, class F> requires IsBag<Bag>
+constexpr auto stream_into(const Bag &bag, F f) noexcept {
+	return helpers::stream_into_t<decltype(bag.get_ref()), F>{bag.get_ref(), f};
+}
+
+template<IsTraverser T, class Bag, class F>
+inline void operator|(const T &t, const helpers::stream_into_t<Bag, F> &s) {
+	using dims = helpers::stream_into_dims<traversal_dims<T>>;
+	using value_type = scalar_t<decltype(s.bag.structure())>;
+	using order = std::remove_cvref_t<decltype(t.get_order())>;
+	constexpr auto dim = dims::inner;
+	static_assert(std::is_trivially_copyable_v<value_type> && std::is_trivially_default_constructible_v<value_type>, "The elements of the bag must be trivially copyable");
+
+	const auto bag = s.bag;
+	const auto f = s.f;
+	const stream_scope scope;
+
+	if constexpr (helpers::chunk_innermost<dim, typename decltype(bag.structure())::signature>::value && helpers::chunk_order_contiguous<dim, order>::value) {
+		// the values of (a part of) a run, small enough to stay in L1
+		constexpr std::size_t block = 4096 / sizeof(value_type);
+		alignas(helpers::stream_vector_bytes) value_type buffer[block];
+
+		[&]<auto ...Outer>(dim_sequence<Outer...>) {
+			t | for_dims<Outer...>([&](auto inner) {
+				const std::size_t length = inner.top_struct().template length<dim>(empty_state);
+				if (length == 0)
+					return;
+
+				value_type *const first = &bag[(inner ^ fix<dim>(std::size_t(0))).state()];
+				if (length > 1 && &bag[(inner ^ fix<dim>(std::size_t(1))).state()] != first + 1) {
+					inner | [&](auto state) { helpers::stream_store(&bag[state], value_type(f(state))); };
+					return;
+				}
+
+				for (std::size_t begin = 0; begin < length; begin += block) {
+					const std::size_t end = std::min(begin + block, length);
+					value_type *out = buffer;
+					inner ^ span<dim>(begin, end) | [&](auto state) { *out++ = value_type(f(state)); };
+					helpers::stream_copy(first + begin, buffer, end - begin);
+				}
+			});
+		}(typename dims::outer());
+	} else {
+		t | [&](auto state) { helpers::stream_store(&bag[state], value_type(f(state))); };
+	}
+}
+
+template<class Bag>
+struct to_struct<streaming_bag_t<Bag>> {
+	using type = typename to_struct<Bag>::type;
+	static constexpr type convert(const streaming_bag_t<Bag> &b) noexcept { return to_struct<Bag>::convert(b.bag()); }
+};
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_STREAMING_HPP
@@ -1,7 +1,9 @@
 #ifndef NOARR_STRUCTURES_TRAVERSER_HPP
 #define NOARR_STRUCTURES_TRAVERSER_HPP
 
+#include <cassert>
 #include <cstddef>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -19,27 +21,88 @@ namespace helpers {
 
 template<class Sig1, class Sig2>
 struct sig_union2;
+
+// the length of a dimension shared by several structures: a static length is preferred to a dynamic one, which is preferred to an unknown one
+template<class ArgLength1, class ArgLength2>
+struct sig_union_arg_length {
+	static_assert(!ArgLength1::is_static || !ArgLength2::is_static || std::is_same_v<ArgLength1, ArgLength2>, "The structures in a union have different static lengths of a dimension");
+	using type = std::conditional_t<ArgLength1::is_static || (ArgLength1::is_known && !ArgLength2::is_static) || !ArgLength2::is_known, ArgLength1, ArgLength2>;
+};
+
+template<class ArgLength2>
+struct sig_union_length_replacement {
+	template<class Original>
+	struct replacement { using type = Original; };
+	template<IsDim auto Dim, class ArgLength1, class RetSig>
+	struct replacement<function_sig<Dim, ArgLength1, RetSig>> { using type = function_sig<Dim, typename sig_union_arg_length<ArgLength1, ArgLength2>::type, RetSig>; };
+};
+
 template<class Sig1, IsDim auto Dim, class ArgLength, class RetSig>
 struct sig_union2<Sig1, function_sig<Dim, ArgLength, RetSig>> {
 	using ret = typename sig_union2<Sig1, RetSig>::type;
 	template<bool = Sig1::template any_accept<Dim>, class = void>
 	struct ty;
 	template<class Useless>
-	struct ty<true, Useless> { using pe = ret; }; // TODO ArgLength union
+	struct ty<true, Useless> { using pe = typename ret::template replace<sig_union_length_replacement<ArgLength>::template replacement, Dim>; };
 	template<class Useless>
 	struct ty<false, Useless> { using pe = function_sig<Dim, ArgLength, ret>; };
 	using type = typename ty<>::pe;
 };
+
+// the signature `Sig` with the dependent dimension `Dim` removed, keeping only its branch `I`
+template<IsDim auto Dim, std::size_t I, class Sig>
+struct sig_union_select;
+template<IsDim auto Dim, std::size_t I, IsDim auto SigDim, class ArgLength, class RetSig>
+struct sig_union_select<Dim, I, function_sig<SigDim, ArgLength, RetSig>> {
+	static_assert(Dim != SigDim, "A dimension of a union is dependent (a tuple) only in some of the structures");
+	using type = function_sig<SigDim, ArgLength, typename sig_union_select<Dim, I, RetSig>::type>;
+};
+template<IsDim auto Dim, std::size_t I, IsDim auto SigDim, class ...RetSigs>
+struct sig_union_select<Dim, I, dep_function_sig<SigDim, RetSigs...>> {
+	using type = dep_function_sig<SigDim, typename sig_union_select<Dim, I, RetSigs>::type...>;
+};
+template<IsDim auto Dim, std::size_t I, class ...RetSigs> requires (I < sizeof...(RetSigs))
+struct sig_union_select<Dim, I, dep_function_sig<Dim, RetSigs...>> {
+	using type = std::tuple_element_t<I, std::tuple<RetSigs...>>;
+};
+template<IsDim auto Dim, std::size_t I, class ...RetSigs> requires (I >= sizeof...(RetSigs))
+struct sig_union_select<Dim, I, dep_function_sig<Dim, RetSigs...>> {
+	static_assert(value_always_false<Dim>, "The tuples in a union have different numbers of fields");
+};
+template<IsDim auto Dim, std::size_t I, class ValueType>
+struct sig_union_select<Dim, I, scalar_sig<ValueType>> {
+	using type = scalar_sig<ValueType>;
+};
+
+// each branch of the dependent dimension is united with the corresponding branch of `Sig1` (if `Sig1` has the dimension too) or with the whole `Sig1`
+template<class Sig1, class Is, IsDim auto Dim, class ...RetSigs>
+struct sig_union_dep;
+template<class Sig1, std::size_t ...Is, IsDim auto Dim, class ...RetSigs>
+struct sig_union_dep<Sig1, std::index_sequence<Is...>, Dim, RetSigs...> {
+	template<std::size_t I>
+	using sig1_branch = typename std::conditional_t<Sig1::template any_accept<Dim>, sig_union_select<Dim, I, Sig1>, std::type_identity<Sig1>>::type;
+	using type = dep_function_sig<Dim, typename sig_union2<sig1_branch<Is>, RetSigs>::type...>;
+};
 template<class Sig1, IsDim auto Dim, class ...RetSigs>
 struct sig_union2<Sig1, dep_function_sig<Dim, RetSigs...>> {
-	// TODO
-	static_assert(value_always_false<Dim>, "Unsupported");
+	using type = typename sig_union_dep<Sig1, std::index_sequence_for<RetSigs...>, Dim, RetSigs...>::type;
 };
 template<class Sig1, class ValueType>
 struct sig_union2<Sig1, scalar_sig<ValueType>> {
 	using type = Sig1;
 };
 
+// how much is known about the length of the dimension `QDim` in a signature (in the branches of the tuples selected by `State`):
+// 2 for a static length, 1 for a dynamic one, 0 for an unknown one (or if the dimension is not there); as in `sig_union_arg_length`
+template<auto QDim, IsState State, class Signature>
+struct sig_known_length : std::integral_constant<int, 0> {};
+template<auto QDim, IsState State, IsDim auto Dim, class ArgLength, class RetSig>
+struct sig_known_length<QDim, State, function_sig<Dim, ArgLength, RetSig>>
+	: std::conditional_t<Dim == QDim, std::integral_constant<int, ArgLength::is_static ? 2 : ArgLength::is_known ? 1 : 0>, sig_known_length<QDim, State, RetSig>> {};
+template<auto QDim, IsState State, IsDim auto Dim, class ...RetSigs> requires (Dim != QDim && State::template contains<index_in<Dim>>)
+struct sig_known_length<QDim, State, dep_function_sig<Dim, RetSigs...>>
+	: sig_known_length<QDim, State, typename dep_function_sig<Dim, RetSigs...>::template ret_sig<state_get_t<State, index_in<Dim>>::value>> {};
+
 template<class ...Sigs>
 struct sig_union;
 template<class Sig1, class Sig2, class ...Sigs>
@@ -102,10 +165,37 @@ private:
 	template<auto Dim> requires IsDim<decltype(Dim)>
 	static constexpr std::size_t first_match = decltype(std::declval<union_t<Structs...>>().template find_first_match<Dim, 0>())::value;
 
+	template<auto Dim, IsState State> requires IsDim<decltype(Dim)>
+	static constexpr int known_length[] = {helpers::sig_known_length<Dim, State, typename to_struct<Structs>::type::signature>::value...};
+
+	// the first structure in which the length of `Dim` is static, or the first one in which it is known, or the first one with `Dim`
+	// (the same preference as in the signature of the union)
+	template<auto Dim, IsState State> requires IsDim<decltype(Dim)>
+	static constexpr std::size_t length_match = [] {
+		for (int known = 2; known > 0; known--)
+			for (std::size_t i = 0; i < sizeof...(Structs); i++)
+				if (known_length<Dim, State>[i] == known)
+					return i;
+		return first_match<Dim>;
+	}();
+
+	// checks that all the structures which know the length of `Dim` agree on it
+	template<auto Dim, IsState State, std::size_t ...Is>
+	constexpr bool consistent_length(std::size_t length, State state, std::index_sequence<Is...>) const noexcept {
+		return (... && [&] {
+			if constexpr (known_length<Dim, State>[Is] != 0)
+				return std::size_t(strict_contain<Structs...>::template get<Is>().template length<Dim>(state)) == length;
+			else
+				return true;
+		}());
+	}
+
 public:
 	template<auto QDim, IsState State> requires IsDim<decltype(QDim)>
 	constexpr auto length(State state) const noexcept {
-		return strict_contain<Structs...>::template get<first_match<QDim>>().template length<QDim>(state);
+		const auto length = strict_contain<Structs...>::template get<length_match<QDim, State>>().template length<QDim>(state);
+		assert(consistent_length<QDim>(std::size_t(length), state, is()) && "The structures in a union have different lengths of a dimension");
+		return length;
 	}
 };
 
@@ -173,6 +263,9 @@ struct traverser_t : strict_contain<Struct, Order> {
 	constexpr auto begin() const noexcept; // defined in traverser_iter.hpp
 	constexpr auto end() const noexcept; // defined in traverser_iter.hpp
 
+	template<auto Dim, class ...Bags> requires IsDim<decltype(Dim)>
+	constexpr auto chunks(const Bags &...bags) const noexcept; // defined in traverser_iter.hpp
+
 private:
 	template<auto Dim, class Branch, class ...Branches, class F, std::size_t I, std::size_t ...Is>
 	constexpr void for_each_impl_dep(F f, auto state, std::index_sequence<I, Is...>) const {
@@ -187,8 +280,10 @@ private:
 		if constexpr(dim_sig::dependent) {
 			for_each_impl_dep<Dim, Branches...>(f, state, std::index_sequence_for<Branches...>());
 		} else {
-			std::size_t len = top_struct().template length<Dim>(state);
-			for(std::size_t i = 0; i < len; i++)
+			// the index has the type of the length (e.g. `std::uint32_t`), a static length is traversed with `std::size_t`
+			const auto len = top_struct().template length<Dim>(state);
+			using index_t = good_index_t<decltype(+len)>;
+			for(index_t i = 0; i < len; i++)
 				for_each_impl(Branches()..., f, state.template with<index_in<Dim>>(i));
 		}
 	}
@@ -0,0 +1,184 @@
+#ifndef NOARR_STRUCTURES_TRIANGULAR_HPP
+#define NOARR_STRUCTURES_TRIANGULAR_HPP
+
+#include <cstddef>
+#include <utility>
+
+#include "../base/contain.hpp"
+#include "../base/state.hpp"
+#include "../base/utility.hpp"
+#include "../structs/slice.hpp"
+#include "../extra/traverser.hpp"
+
+namespace noarr {
+
+template<class Traverser, class Triangle>
+struct triangular_range_t;
+
+/**
+ * @brief describes a triangular iteration space: for each index `row` of `DimRow`, the dimension `DimCol` is restricted to
+ * `[0, row + offset())` (the lower triangle, `Upper == false`, e.g. `span<DimCol>(row + 1)`) or
+ * `[row + offset(), length)` (the upper triangle, `Upper == true`, e.g. `shift<DimCol>(row + 1)`), clipped to the length of `DimCol`
+ *
+ * The amount of work per row then changes linearly with the row index; the parallel range (see `range`) splits the rows
+ * so that both halves contain the same number of elements (each row also counts as one element, for its overhead).
+ */
+template<IsDim auto DimRow, IsDim auto DimCol, bool Upper, class OffsetT>
+struct triangular_t : strict_contain<OffsetT> {
+	using strict_contain<OffsetT>::strict_contain;
+
+	static_assert(DimRow != DimCol, "The row and column dimensions of a triangle must differ");
+
+	constexpr OffsetT offset() const noexcept { return this->get(); }
+
+	/**
+	 * @brief returns the number of rows of the triangle in the traverser `t`
+	 */
+	template<IsTraverser T>
+	constexpr std::size_t rows(const T &t) const noexcept {
+		return t.top_struct().template length<DimRow>(empty_state);
+	}
+
+	/**
+	 * @brief returns the first column and the number of columns of the row `row` of the triangle in the traverser `t`
+	 */
+	template<IsTraverser T>
+	constexpr std::pair<std::size_t, std::size_t> columns(const T &t, std::size_t row) const noexcept {
+		const std::size_t len = t.top_struct().template length<DimCol>(empty_state);
+		const std::size_t bound = row + std::size_t(offset()) < len ? row + std::size_t(offset()) : len;
+		if constexpr (Upper)
+			return {bound, len - bound};
+		else
+			return {0, bound};
+	}
+
+	/**
+	 * @brief returns the traverser `t` restricted to the row `row` of the triangle (with `DimRow` fixed)
+	 */
+	template<IsTraverser T>
+	constexpr auto row(const T &t, std::size_t row) const noexcept {
+		const auto [first, count] = columns(t, row);
+		return t ^ fix<DimRow>(row) ^ slice<DimCol>(first, count);
+	}
+
+	/**
+	 * @brief returns the work (the number of elements plus the number of rows) in the rows `[0, end)` of the triangle in the traverser `t`
+	 */
+	template<IsTraverser T>
+	constexpr std::size_t work_before(const T &t, std::size_t end) const noexcept {
+		const std::size_t len = t.top_struct().template length<DimCol>(empty_state);
+		const std::size_t off = offset();
+		// the rows [0, unclipped) are not clipped by the length of `DimCol`
+		const std::size_t unclipped = off >= len ? 0 : end < len - off ? end : len - off;
+		const std::size_t clipped = end - unclipped;
+		const std::size_t triangle = unclipped * (unclipped - (unclipped != 0)) / 2;
+		if constexpr (Upper)
+			return end + unclipped * (len - off) - triangle;
+		else
+			return end + unclipped * off + triangle + clipped * len;
+	}
+
+	/**
+	 * @brief returns the row that splits the rows `[begin, end)` into two parts with (as close as possible to) the same work
+	 */
+	template<IsTraverser T>
+	constexpr std::size_t split_row(const T &t, std::size_t begin, std::size_t end) const noexcept {
+		const std::size_t base = work_before(t, begin);
+		const std::size_t half = (work_before(t, end) - base) / 2;
+		std::size_t lo = begin + 1, hi = end - 1;
+		while (lo < hi) {
+			const std::size_t mid = lo + (hi - lo) / 2;
+			if (work_before(t, mid) - base < half)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		return lo;
+	}
+
+	/**
+	 * @brief traverses the triangle in the traverser `t`, calling `f(state)`
+	 */
+	template<IsTraverser T, class F>
+	constexpr void for_each(const T &t, F f) const {
+		range(t).for_each(f);
+	}
+
+	/**
+	 * @brief calls `f(inner)` for each row of the triangle in the traverser `t`, where `inner` is the traverser restricted to the row (see `row`)
+	 */
+	template<IsTraverser T, class F>
+	constexpr void for_sections(const T &t, F f) const {
+		range(t).for_sections(f);
+	}
+
+	/**
+	 * @brief returns a range of the rows of the triangle in the traverser `t`; when split (e.g. by TBB), the rows are divided by work
+	 */
+	template<IsTraverser T>
+	constexpr auto range(const T &t) const noexcept {
+		return triangular_range_t<T, triangular_t>(t, *this, 0, rows(t));
+	}
+};
+
+/**
+ * @brief a range of the rows `[begin_idx, end_idx)` of a triangular iteration space (see `triangular_t`)
+ */
+template<class Traverser, class Triangle>
+struct triangular_range_t : strict_contain<Traverser, Triangle> {
+	using base = strict_contain<Traverser, Triangle>;
+	std::size_t begin_idx, end_idx;
+
+	constexpr triangular_range_t(const Traverser &traverser, const Triangle &triangle, std::size_t begin_idx, std::size_t end_idx) noexcept
+		: base(traverser, triangle), begin_idx(begin_idx), end_idx(end_idx) {}
+
+	// TBB splitting constructor (the split tag is not used, so the range can also be split without TBB)
+	template<class Split>
+	constexpr triangular_range_t(triangular_range_t &orig, Split) noexcept
+		: base(orig), begin_idx(orig.get_triangle().split_row(orig.get_traverser(), orig.begin_idx, orig.end_idx)), end_idx(orig.end_idx) {
+		orig.end_idx = begin_idx;
+	}
+
+	constexpr Traverser get_traverser() const noexcept { return this->template get<0>(); }
+	constexpr Triangle get_triangle() const noexcept { return this->template get<1>(); }
+
+	/**
+	 * @brief returns the work in the range (see `triangular_t::work_before`)
+	 */
+	constexpr std::size_t work() const noexcept {
+		return get_triangle().work_before(get_traverser(), end_idx) - get_triangle().work_before(get_traverser(), begin_idx);
+	}
+
+	template<class F>
+	constexpr void for_each(F f) const {
+		for (std::size_t i = begin_idx; i < end_idx; i++)
+			get_triangle().row(get_traverser(), i).for_each(f);
+	}
+
+	template<class F>
+	constexpr void for_sections(F f) const {
+		for (std::size_t i = begin_idx; i < end_idx; i++)
+			f(get_triangle().row(get_traverser(), i));
+	}
+
+	// empty() and is_divisible() are required by TBB
+	constexpr bool empty() const noexcept { return end_idx == begin_idx; }
+	constexpr bool is_divisible() const noexcept { return end_idx - begin_idx > 1; }
+	constexpr std::size_t size() const noexcept { return end_idx - begin_idx; }
+};
+
+/**
+ * @brief a lower triangle: `DimCol` is restricted to `[0, row + offset)` for each index `row` of `DimRow` (see `triangular_t`)
+ */
+template<IsDim auto DimRow, IsDim auto DimCol, class OffsetT = lit_t<1>>
+constexpr auto lower_triangle(OffsetT offset = {}) noexcept { return triangular_t<DimRow, DimCol, false, good_index_t<OffsetT>>(offset); }
+
+/**
+ * @brief an upper triangle: `DimCol` is restricted to `[row + offset, length)` for each index `row` of `DimRow` (see `triangular_t`)
+ */
+template<IsDim auto DimRow, IsDim auto DimCol, class OffsetT = lit_t<0>>
+constexpr auto upper_triangle(OffsetT offset = {}) noexcept { return triangular_t<DimRow, DimCol, true, good_index_t<OffsetT>>(offset); }
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_TRIANGULAR_HPP
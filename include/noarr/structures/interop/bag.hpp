@@ -1,8 +1,11 @@
 #ifndef NOARR_BAG_HPP
 #define NOARR_BAG_HPP
 
+#include <cassert>
 #include <cstddef>
+#include <functional>
 #include <memory>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
@@ -74,6 +77,32 @@ struct bag_policy<bag_const_raw_pointer_tag> {
 	}
 };
 
+// a helper struct for 'bag_policy': a raw pointer that does not alias the data of any other bag (see `noalias`), the stored pointer is `__restrict`
+template<class...>
+struct bag_restrict_raw_pointer_tag;
+
+// a helper struct for 'bag_policy': a raw pointer that does not alias the data of any other bag (see `noalias`), the stored pointer is `__restrict`
+template<class...>
+struct bag_const_restrict_raw_pointer_tag;
+
+template<>
+struct bag_policy<bag_restrict_raw_pointer_tag> {
+	using type = void *__restrict;
+
+	static constexpr void *get(void *__restrict ptr) noexcept {
+		return ptr;
+	}
+};
+
+template<>
+struct bag_policy<bag_const_restrict_raw_pointer_tag> {
+	using type = const void *__restrict;
+
+	static constexpr const void *get(const void *__restrict ptr) noexcept {
+		return ptr;
+	}
+};
+
 } // namespace helpers
 
 /**
@@ -273,7 +302,56 @@ constexpr auto make_bag(Structure s, const void *data) noexcept {
 
 template<class Structure, class BagPolicy>
 constexpr auto bag_t<Structure, BagPolicy>::get_ref() const noexcept {
-	return make_bag(structure(), data());
+	// a reference to a `noalias` bag keeps the `__restrict` pointer
+	if constexpr (std::is_same_v<BagPolicy, helpers::bag_policy<helpers::bag_restrict_raw_pointer_tag>> || std::is_same_v<BagPolicy, helpers::bag_policy<helpers::bag_const_restrict_raw_pointer_tag>>)
+		return *this;
+	else
+		return make_bag(structure(), data());
+}
+
+template<class Structure>
+using restrict_bag = bag_t<Structure, helpers::bag_policy<helpers::bag_restrict_raw_pointer_tag>>;
+template<class Structure>
+using const_restrict_bag = bag_t<Structure, helpers::bag_policy<helpers::bag_const_restrict_raw_pointer_tag>>;
+
+/**
+ * @brief returns whether the data of the bags do not overlap
+ */
+template<class ...Bags> requires (... && IsBag<Bags>)
+constexpr bool bags_disjoint(const Bags &...bags) noexcept {
+	const char *begins[] = {static_cast<const char *>(bags.data())..., nullptr};
+	const std::size_t sizes[] = {std::size_t(bags.size())..., 0};
+	for (std::size_t i = 0; i < sizeof...(Bags); i++)
+		for (std::size_t j = i + 1; j < sizeof...(Bags); j++)
+			if (std::less<>()(begins[i], begins[j] + sizes[j]) && std::less<>()(begins[j], begins[i] + sizes[i]))
+				return false;
+	return true;
+}
+
+/**
+ * @brief returns a non-owning reference to the data of the bag (as `get_ref`) whose pointer is `__restrict`-qualified:
+ * the compiler may assume that the data is accessed only through this bag (while it is used), so it does not have to guard
+ * the vectorized loops of a traversal with run-time alias checks (or fall back to scalar code)
+ */
+template<class Structure, class BagPolicy>
+constexpr auto noalias(const bag_t<Structure, BagPolicy> &bag) noexcept {
+	if constexpr (std::is_convertible_v<decltype(bag.data()), void *>)
+		return restrict_bag<Structure>(bag.structure(), bag.data());
+	else
+		return const_restrict_bag<Structure>(bag.structure(), bag.data());
+}
+
+/**
+ * @brief returns a tuple of the `noalias` references to the bags, e.g. `auto [c, a, b] = noalias(C, A, B);`
+ *
+ * With `NOARR_CHECK_NOALIAS` defined, it is asserted that the data of the bags do not overlap (see `bags_disjoint`).
+ */
+template<class ...Bags> requires (sizeof...(Bags) > 1 && (... && IsBag<Bags>))
+constexpr auto noalias(const Bags &...bags) noexcept {
+#ifdef NOARR_CHECK_NOALIAS
+	assert(bags_disjoint(bags...) && "The data of noalias bags overlap");
+#endif
+	return std::tuple(noalias(bags)...);
 }
 
 
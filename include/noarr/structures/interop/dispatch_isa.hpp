@@ -0,0 +1,37 @@
+#ifndef NOARR_STRUCTURES_DISPATCH_ISA_HPP
+#define NOARR_STRUCTURES_DISPATCH_ISA_HPP
+
+#include <type_traits>
+#include <utility>
+
+// The instruction sets a kernel is compiled for by `dispatch_isa` (in the syntax of `gnu::target_clones`, "default" has to be present);
+// can be defined before including this file, e.g. `#define NOARR_ISA_CLONES "avx512f", "default"`
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && !defined(NOARR_NO_ISA_DISPATCH)
+#ifndef NOARR_ISA_CLONES
+#define NOARR_ISA_CLONES "arch=x86-64-v4", "arch=x86-64-v3", "default"
+#endif
+// an attribute compiling a function for each of `NOARR_ISA_CLONES`, the clone is selected when the program is loaded (using CPUID)
+#define NOARR_TARGET_CLONES gnu::target_clones(NOARR_ISA_CLONES)
+#else
+#define NOARR_TARGET_CLONES
+#endif
+
+namespace noarr {
+
+/**
+ * @brief calls `kernel(args...)` compiled for the best of the instruction sets in `NOARR_ISA_CLONES` supported by the CPU
+ * (e.g. with AVX-512 where available and with AVX2 or the baseline elsewhere), so that a single binary uses the full vector width
+ *
+ * The kernel (typically a lambda traversing the structures) is inlined into each clone, together with everything it calls;
+ * functions marked `noinline` are called as they are (such functions can be annotated with `[[NOARR_TARGET_CLONES]]` themselves).
+ * Without the compiler support (or with `NOARR_NO_ISA_DISPATCH` defined), the kernel is just called.
+ */
+template<class Kernel, class ...Args>
+[[NOARR_TARGET_CLONES, gnu::flatten]]
+inline std::invoke_result_t<Kernel &, Args &&...> dispatch_isa(Kernel kernel, Args &&...args) {
+	return kernel(std::forward<Args>(args)...);
+}
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_DISPATCH_ISA_HPP
@@ -5,6 +5,8 @@
 
 #include "../interop/traverser_iter.hpp"
 #include "../interop/planner_iter.hpp"
+#include "../extra/gemm.hpp"
+#include "../extra/triangular.hpp"
 
 #if !defined(_OPENMP)
 #error "This file should only be included when OpenMP is enabled"
@@ -31,6 +33,93 @@ inline void omp_for_sections(const Traverser &t, const F &f) {
 	}
 }
 
+/**
+ * @brief traverses the triangular iteration space `triangle` of `t` in parallel; the rows are divided into chunks
+ * of the same work (see `triangular_t`), `chunks_per_thread` of them per thread
+ */
+template<IsTraverser Traverser, IsDim auto DimRow, IsDim auto DimCol, bool Upper, class OffsetT, class F>
+inline void omp_for_each(const Traverser &t, const triangular_t<DimRow, DimCol, Upper, OffsetT> &triangle, const F &f, std::size_t chunks_per_thread = 1) {
+	const std::size_t rows = triangle.rows(t);
+	const std::size_t total = triangle.work_before(t, rows);
+	const std::size_t chunks = std::size_t(omp_get_max_threads()) * chunks_per_thread;
+
+	// the first row of the chunk `c` is the first row that starts at or after `c / chunks` of the work
+	const auto chunk_begin = [&](std::size_t c) {
+		std::size_t lo = 0, hi = rows;
+		while (lo < hi) {
+			const std::size_t mid = lo + (hi - lo) / 2;
+			if (triangle.work_before(t, mid) * chunks < total * c)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		return lo;
+	};
+
+	#pragma omp parallel for schedule(static, 1)
+	for(std::size_t c = 0; c < chunks; c++) {
+		triangular_range_t<Traverser, triangular_t<DimRow, DimCol, Upper, OffsetT>>(t, triangle, chunk_begin(c), chunk_begin(c + 1)).for_each(f);
+	}
+}
+
+namespace helpers {
+
+// a worksharing loop to be called from within a parallel region (it cannot be placed directly in a generic lambda)
+template<IsTraverser Traverser, class F>
+inline void omp_for_each_orphaned(const Traverser &t, const F &f) {
+	#pragma omp for
+	for(auto t_inner : t) {
+		t_inner.for_each(f);
+	}
+}
+
+} // namespace helpers
+
+/**
+ * @brief traverses the dimension `Dim` sequentially and, for each of its indices, the rest of the traversal in parallel;
+ * the threads are created once and synchronized only at the end of each index of `Dim` (e.g. a wavefront, see `skew`)
+ */
+template<auto Dim, IsTraverser Traverser, class F> requires IsDim<decltype(Dim)>
+inline void omp_for_each_wavefront(const Traverser &t, const F &f) {
+	#pragma omp parallel
+	t.template for_dims<Dim>([&f](auto wave) {
+		helpers::omp_for_each_orphaned(wave, f);
+	});
+}
+
+namespace helpers {
+
+struct omp_gemm_executor {
+	template<class F>
+	void operator()(std::size_t n, const F &f) const {
+		#pragma omp parallel for schedule(dynamic)
+		for(std::size_t b = 0; b < n; b++) {
+			f(b);
+		}
+	}
+};
+
+} // namespace helpers
+
+/**
+ * @brief the matrix product `C = alpha * A * B + beta * C` (see `gemm`), the packing of A and B and the products of their panels
+ * (the tiles of C) are computed in parallel
+ */
+template<auto DimI, auto DimJ, auto DimK, class CBag, class ABag, class BBag, class Scalar>
+requires IsDimPack<decltype(DimI), decltype(DimJ), decltype(DimK)>
+inline void omp_gemm(const CBag &C, const ABag &A, const BBag &B, Scalar alpha, Scalar beta) {
+	helpers::gemm_impl<DimI, DimJ, DimK>(helpers::omp_gemm_executor(), C, A, B, alpha, beta);
+}
+
+/**
+ * @brief the parallel matrix product (see above), the dimensions are inferred from the dimensions of the matrices (see `gemm`)
+ */
+template<class CBag, class ABag, class BBag, class Scalar>
+inline void omp_gemm(const CBag &C, const ABag &A, const BBag &B, Scalar alpha, Scalar beta) {
+	using dims = helpers::gemm_dims<helpers::gemm_bag_dims<CBag>, helpers::gemm_bag_dims<ABag>, helpers::gemm_bag_dims<BBag>>;
+	omp_gemm<dims::i, dims::j, dims::k>(C, A, B, alpha, beta);
+}
+
 struct planner_omp_execute_t {};
 
 constexpr planner_omp_execute_t planner_omp_execute() noexcept {
@@ -10,6 +10,9 @@
 #include "../interop/bag.hpp"
 #include "../interop/traverser_iter.hpp"
 #include "../interop/planner_iter.hpp"
+#include "../extra/gemm.hpp"
+#include "../extra/recursive_bisect.hpp"
+#include "../extra/triangular.hpp"
 
 namespace noarr {
 
@@ -26,6 +29,71 @@ inline void tbb_for_each(const Traverser &t, const F &f) {
 	tbb::parallel_for(t.range(), [&f](const auto &subrange) { subrange.for_each(f); });
 }
 
+/**
+ * @brief traverses the dimension `Dim` sequentially and, for each of its indices, the rest of the traversal in parallel
+ * (e.g. a wavefront, see `skew`)
+ */
+template<auto Dim, IsTraverser Traverser, class F> requires IsDim<decltype(Dim)>
+inline void tbb_for_each_wavefront(const Traverser &t, const F &f) {
+	t.template for_dims<Dim>([&f](auto wave) {
+		tbb_for_each(wave, f);
+	});
+}
+
+/**
+ * @brief traverses the triangular iteration space `triangle` of `t` in parallel, splitting the rows by work (see `triangular_t`)
+ */
+template<IsTraverser Traverser, IsDim auto DimRow, IsDim auto DimCol, bool Upper, class OffsetT, class F>
+inline void tbb_for_each(const Traverser &t, const triangular_t<DimRow, DimCol, Upper, OffsetT> &triangle, const F &f) {
+	tbb::parallel_for(triangle.range(t), [&f](const auto &subrange) { subrange.for_each(f); });
+}
+
+/**
+ * @brief calls `f(inner)` for each row of the triangular iteration space `triangle` of `t` in parallel, splitting the rows by work
+ */
+template<IsTraverser Traverser, IsDim auto DimRow, IsDim auto DimCol, bool Upper, class OffsetT, class F>
+inline void tbb_for_sections(const Traverser &t, const triangular_t<DimRow, DimCol, Upper, OffsetT> &triangle, const F &f) {
+	tbb::parallel_for(triangle.range(t), [&f](const auto &subrange) { subrange.for_sections(f); });
+}
+
+namespace helpers {
+
+template<auto Dim, auto ...Dims>
+constexpr bool tbb_dim_among = (false || ... || (Dim == Dims));
+
+template<auto ...SequentialDims, class LeafT, auto ...Dims, IsTraverser Traverser, class F>
+inline void tbb_bisect(const recursive_bisect_t<LeafT, Dims...> &bisect, const Traverser &t,
+		typename recursive_bisect_t<LeafT, Dims...>::box lo, typename recursive_bisect_t<LeafT, Dims...>::box len, const F &f) {
+	constexpr bool sequential[] = {tbb_dim_among<Dims, SequentialDims...>...};
+
+	const std::size_t dim = bisect.split_dim(len);
+	if (dim == sizeof...(Dims)) {
+		bisect.tile(t, lo, len).for_each(f);
+		return;
+	}
+
+	const auto [hi_lo, hi_len] = bisect.split(dim, lo, len);
+	const auto lower = [&, lo = lo, len = len] { tbb_bisect<SequentialDims...>(bisect, t, lo, len, f); };
+	const auto upper = [&, hi_lo = hi_lo, hi_len = hi_len] { tbb_bisect<SequentialDims...>(bisect, t, hi_lo, hi_len, f); };
+	if (sequential[dim]) {
+		lower();
+		upper();
+	} else {
+		tbb::parallel_invoke(lower, upper);
+	}
+}
+
+} // namespace helpers
+
+/**
+ * @brief traverses `t` in the recursive-bisection order (see `recursive_bisect`), running the halves of each split as parallel tasks;
+ * the halves of a split along any of `SequentialDims` (e.g. a reduction dimension) are run one after the other, in the original order
+ */
+template<auto ...SequentialDims, class LeafT, auto ...Dims, IsTraverser Traverser, class F> requires IsDimPack<decltype(SequentialDims)...>
+inline void tbb_for_each_bisect(const Traverser &t, const recursive_bisect_t<LeafT, Dims...> &bisect, const F &f) {
+	helpers::tbb_bisect<SequentialDims...>(bisect, t, {}, bisect.lengths(t), f);
+}
+
 template<IsTraverser Traverser, class F>
 inline void tbb_for_sections(const Traverser &t, const F &f) {
 	tbb::parallel_for(t.range(), [&f](const auto &subrange) {
@@ -100,6 +168,36 @@ inline void tbb_reduce(const Traverser &t, const FNeut &f_neut, const FAcc &f_ac
 		out_bag.data());
 }
 
+namespace helpers {
+
+struct tbb_gemm_executor {
+	template<class F>
+	void operator()(std::size_t n, const F &f) const {
+		tbb::parallel_for(std::size_t(0), n, [&f](std::size_t b) { f(b); });
+	}
+};
+
+} // namespace helpers
+
+/**
+ * @brief the matrix product `C = alpha * A * B + beta * C` (see `gemm`), the packing of A and B and the products of their panels
+ * (the tiles of C) are computed in parallel
+ */
+template<auto DimI, auto DimJ, auto DimK, class CBag, class ABag, class BBag, class Scalar>
+requires IsDimPack<decltype(DimI), decltype(DimJ), decltype(DimK)>
+inline void tbb_gemm(const CBag &C, const ABag &A, const BBag &B, Scalar alpha, Scalar beta) {
+	helpers::gemm_impl<DimI, DimJ, DimK>(helpers::tbb_gemm_executor(), C, A, B, alpha, beta);
+}
+
+/**
+ * @brief the parallel matrix product (see above), the dimensions are inferred from the dimensions of the matrices (see `gemm`)
+ */
+template<class CBag, class ABag, class BBag, class Scalar>
+inline void tbb_gemm(const CBag &C, const ABag &A, const BBag &B, Scalar alpha, Scalar beta) {
+	using dims = helpers::gemm_dims<helpers::gemm_bag_dims<CBag>, helpers::gemm_bag_dims<ABag>, helpers::gemm_bag_dims<BBag>>;
+	tbb_gemm<dims::i, dims::j, dims::k>(C, A, B, alpha, beta);
+}
+
 struct planner_tbb_execute_t {};
 
 constexpr planner_tbb_execute_t planner_tbb_execute() noexcept {
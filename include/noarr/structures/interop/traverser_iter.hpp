@@ -1,14 +1,20 @@
 #ifndef NOARR_STRUCTURES_TRAVERSER_ITER_HPP
 #define NOARR_STRUCTURES_TRAVERSER_ITER_HPP
 
+#include <cassert>
 #include <cstddef>
 #include <iterator>
+#include <span>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 #include "../base/contain.hpp"
 #include "../base/signature.hpp"
 #include "../base/state.hpp"
 #include "../extra/traverser.hpp"
+#include "../extra/struct_traits.hpp"
+#include "../structs/blocks.hpp"
 #include "../structs/setters.hpp"
 #include "../structs/slice.hpp"
 
@@ -130,6 +136,181 @@ static constexpr auto traviter_top_dim = traviter_sig_top_dim<typename Struct::s
 
 } // namespace helpers
 
+/**
+ * @brief an iterator over the indices of the dimension `Dim` of a traverser that yields, for each index, `std::span`s
+ * of the elements of the bags `Bags` along the dimension `DimChunk` (or a single span if there is only one bag)
+ */
+template<auto Dim, auto DimChunk, class Struct, class Order, class ...Bags> requires IsDim<decltype(Dim)> && IsDim<decltype(DimChunk)>
+struct traverser_chunk_iterator_t {
+	using this_t = traverser_chunk_iterator_t;
+	using iter_t = traverser_iterator_t<Dim, Struct, Order>;
+
+	iter_t iter;
+	std::tuple<Bags...> bags;
+
+	constexpr traverser_chunk_iterator_t(const iter_t &iter, const std::tuple<Bags...> &bags) noexcept : iter(iter), bags(bags) {}
+
+	using difference_type = std::ptrdiff_t;
+	using value_type = std::conditional_t<sizeof...(Bags) == 1,
+		std::tuple_element_t<0, std::tuple<std::span<scalar_t<decltype(std::declval<Bags>().structure())>>...>>,
+		std::tuple<std::span<scalar_t<decltype(std::declval<Bags>().structure())>>...>>;
+	using reference = value_type;
+	using iterator_category = std::random_access_iterator_tag;
+
+	[[deprecated("The default iterator for traversers is not well-definable")]] explicit constexpr traverser_chunk_iterator_t() noexcept : iter(), bags() {}
+
+	constexpr difference_type operator-(const this_t &other) const noexcept { return iter - other.iter; }
+	constexpr this_t operator+(difference_type diff) const noexcept { return this_t(iter + diff, bags); }
+	constexpr this_t operator-(difference_type diff) const noexcept { return this_t(iter - diff, bags); }
+	constexpr this_t &operator+=(difference_type diff) noexcept { iter += diff; return *this; }
+	constexpr this_t &operator-=(difference_type diff) noexcept { iter -= diff; return *this; }
+	constexpr this_t &operator++() noexcept { ++iter; return *this; }
+	constexpr this_t &operator--() noexcept { --iter; return *this; }
+	this_t operator++(int) noexcept { const auto copy = *this; ++iter; return copy; }
+	this_t operator--(int) noexcept { const auto copy = *this; --iter; return copy; }
+
+	constexpr bool operator==(const this_t &other) const noexcept { return iter == other.iter; }
+	constexpr auto operator<=>(const this_t &other) const noexcept { return iter <=> other.iter; }
+
+	constexpr value_type operator*() const noexcept { return chunk(*iter); }
+	constexpr value_type operator[](difference_type i) const noexcept { return chunk(iter[i]); }
+
+	friend constexpr this_t operator+(difference_type diff, const this_t &iter) noexcept { return iter + diff; }
+
+private:
+	template<class Inner>
+	constexpr value_type chunk(const Inner &inner) const noexcept {
+		using signature = typename decltype(inner.top_struct())::signature;
+		static_assert(signature::dim == DimChunk && IsGroundSig<typename signature::ret_sig>,
+			"The chunked dimension must be the only dimension left after fixing the iterated one");
+
+		// the first element of the chunk (fixed through the order, which may e.g. shift the chunked dimension)
+		const auto state = (inner ^ fix<DimChunk>(std::size_t(0))).state();
+		const std::size_t length = inner.top_struct().template length<DimChunk>(empty_state);
+
+		// the order keeps the chunk ascending with a unit step (see `helpers::chunk_order_contiguous`), the layouts have to be contiguous too
+		if (length > 1) {
+			[[maybe_unused]] const auto next = (inner ^ fix<DimChunk>(std::size_t(1))).state();
+			assert(std::apply([&](const auto &...bags) { return (... && (&bags[next] == &bags[state] + 1)); }, bags)
+				&& "The chunked dimension is not contiguous in the layout of a bag");
+		}
+
+		return std::apply([&](const auto &...bags) {
+			return value_type(std::span<scalar_t<decltype(bags.structure())>>(&bags[state], length)...);
+		}, bags);
+	}
+};
+
+/**
+ * @brief a range over the indices of the top-level dimension `Dim` of a traverser yielding spans of the bags along `DimChunk`
+ * (see `traverser_chunk_iterator_t` and `traverser_t::chunks`)
+ *
+ * The order of the traverser must keep `DimChunk` contiguous and ascending (checked at compile time):
+ * e.g. `slice<DimChunk>` is allowed, `step<DimChunk>` and `reverse<DimChunk>` are not.
+ */
+template<auto Dim, auto DimChunk, class Struct, class Order, class ...Bags> requires IsDim<decltype(Dim)> && IsDim<decltype(DimChunk)>
+struct traverser_chunks_t {
+	traverser_range_t<Dim, Struct, Order> range;
+	std::tuple<Bags...> bags;
+
+	using iterator = traverser_chunk_iterator_t<Dim, DimChunk, Struct, Order, Bags...>;
+	using const_iterator = iterator;
+	using value_type = typename iterator::value_type;
+	using reference = typename iterator::reference;
+	using const_reference = const reference;
+	using difference_type = typename iterator::difference_type;
+	using size_type = std::size_t;
+
+	constexpr iterator begin() const noexcept { return iterator(range.begin(), bags); }
+	constexpr iterator end() const noexcept { return iterator(range.end(), bags); }
+	constexpr const_iterator cbegin() const noexcept { return begin(); }
+	constexpr const_iterator cend() const noexcept { return end(); }
+	constexpr size_type size() const noexcept { return range.size(); }
+	constexpr value_type operator[](size_type i) const noexcept { return begin()[i]; }
+};
+
+namespace helpers {
+
+// checks (at compile time) that the dimension `Dim` is the innermost dimension of the signature
+template<auto Dim, class Sig>
+struct chunk_innermost : std::false_type {};
+
+template<auto Dim, class ArgLength, class ValueType>
+struct chunk_innermost<Dim, function_sig<Dim, ArgLength, scalar_sig<ValueType>>> : std::true_type {};
+
+template<auto Dim, auto OtherDim, class ArgLength, class RetSig>
+struct chunk_innermost<Dim, function_sig<OtherDim, ArgLength, RetSig>> : chunk_innermost<Dim, RetSig> {};
+
+// checks (at compile time) that the order maps the consecutive indices of the dimension `Dim` to consecutive ascending indices of the bags;
+// only the orders known to do so are accepted (e.g. `step` or `reverse` of the dimension are not)
+template<auto Dim, class Order>
+struct chunk_order_contiguous : std::false_type {};
+
+template<auto Dim>
+struct chunk_order_contiguous<Dim, neutral_proto> : std::true_type {};
+
+template<auto Dim, class ...InnerProtoStructs, class OuterProtoStruct>
+struct chunk_order_contiguous<Dim, compose_proto<pack<InnerProtoStructs...>, OuterProtoStruct>>
+	: std::bool_constant<(chunk_order_contiguous<Dim, OuterProtoStruct>::value && ... && chunk_order_contiguous<Dim, InnerProtoStructs>::value)> {};
+
+template<auto Dim, auto FixDim, class IdxT>
+struct chunk_order_contiguous<Dim, fix_proto<FixDim, IdxT>> : std::true_type {};
+
+template<auto Dim, auto LenDim, class LenT>
+struct chunk_order_contiguous<Dim, set_length_proto<LenDim, LenT>> : std::true_type {};
+
+// shifting the start of a dimension keeps it contiguous
+template<auto Dim, auto SliceDim, class StartT>
+struct chunk_order_contiguous<Dim, shift_proto<SliceDim, StartT>> : std::true_type {};
+
+template<auto Dim, auto SliceDim, class StartT, class LenT>
+struct chunk_order_contiguous<Dim, slice_proto<SliceDim, StartT, LenT>> : std::true_type {};
+
+template<auto Dim, auto SliceDim, class StartT, class EndT>
+struct chunk_order_contiguous<Dim, span_proto<SliceDim, StartT, EndT>> : std::true_type {};
+
+template<auto Dim, auto StepDim, class StartT, class StrideT>
+struct chunk_order_contiguous<Dim, step_proto<StepDim, StartT, StrideT>> : std::bool_constant<Dim != StepDim> {};
+
+template<auto Dim, auto ReverseDim>
+struct chunk_order_contiguous<Dim, reverse_proto<ReverseDim>> : std::bool_constant<Dim != ReverseDim> {};
+
+// the minor dimension of blocks is contiguous within a block, the major one is not
+template<auto Dim, auto BlockDim, auto DimMajor, auto DimMinor>
+struct chunk_order_contiguous<Dim, into_blocks_proto<BlockDim, DimMajor, DimMinor>> : std::bool_constant<Dim != BlockDim && Dim != DimMajor> {};
+
+template<auto Dim, auto BlockDim, auto DimMajor, auto DimMinor, auto DimIsPresent>
+struct chunk_order_contiguous<Dim, into_blocks_dynamic_proto<BlockDim, DimMajor, DimMinor, DimIsPresent>>
+	: std::bool_constant<Dim != BlockDim && Dim != DimMajor && Dim != DimIsPresent> {};
+
+template<auto Dim, auto BlockDim, auto DimIsBorder, auto DimMajor, auto DimMinor, class MinorLenT>
+struct chunk_order_contiguous<Dim, into_blocks_static_proto<BlockDim, DimIsBorder, DimMajor, DimMinor, MinorLenT>>
+	: std::bool_constant<Dim != BlockDim && Dim != DimMajor && Dim != DimIsBorder> {};
+
+template<auto Dim, auto BlockDim, auto DimMajor, auto DimMinor, class MinorLenT>
+struct chunk_order_contiguous<Dim, into_blocks_clamped_proto<BlockDim, DimMajor, DimMinor, MinorLenT>> : std::bool_constant<Dim != BlockDim && Dim != DimMajor> {};
+
+template<auto Dim, auto DimMajor, auto DimMinor, auto MergedDim>
+struct chunk_order_contiguous<Dim, merge_blocks_proto<DimMajor, DimMinor, MergedDim>> : std::bool_constant<Dim != MergedDim> {};
+
+} // namespace helpers
+
+// declared in traverser.hpp
+template<class Struct, class Order>
+template<auto Dim, class ...Bags> requires IsDim<decltype(Dim)>
+constexpr auto traverser_t<Struct, Order>::chunks(const Bags &...bags) const noexcept {
+	static_assert(sizeof...(Bags) > 0, "At least one bag is needed to yield the chunks of");
+	static_assert((... && helpers::chunk_innermost<Dim, typename decltype(bags.structure())::signature>::value),
+		"The chunked dimension must be the innermost dimension of each bag");
+	static_assert(helpers::chunk_order_contiguous<Dim, Order>::value,
+		"The order has to keep the chunked dimension contiguous and ascending (only fix, set_length, shift, slice, span, and step, reverse and blocks of the other dimensions are supported)");
+
+	constexpr auto dim = helpers::traviter_top_dim<decltype(top_struct())>;
+	static_assert(dim != Dim, "The chunked dimension cannot be the top-level dimension of the traversal");
+
+	return traverser_chunks_t<dim, Dim, Struct, Order, decltype(bags.get_ref())...>{range<dim>(), std::tuple(bags.get_ref()...)};
+}
+
 // declared in traverser.hpp
 template<class Struct, class Order>
 template<auto Dim> requires IsDim<decltype(Dim)>
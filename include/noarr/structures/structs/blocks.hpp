@@ -1,10 +1,13 @@
 #ifndef NOARR_STRUCTURES_BLOCKS_HPP
 #define NOARR_STRUCTURES_BLOCKS_HPP
 
+#include <cassert>
 #include <cstddef>
 #include <type_traits>
+#include <utility>
 
 #include "../base/contain.hpp"
+#include "../base/fast_divisor.hpp"
 #include "../base/signature.hpp"
 #include "../base/state.hpp"
 #include "../base/structs_common.hpp"
@@ -373,9 +376,153 @@ constexpr auto into_blocks_static(MinorLenT minor_length) {
 	return into_blocks_static_proto<Dim, DimIsBorder, DimMajor, DimMinor, good_index_t<MinorLenT>>(minor_length);
 }
 
+/**
+ * @brief splits a dimension into blocks of `minor_length` indices (the last block may be shorter);
+ * the length of the minor dimension depends on the block index, so the major dimension has to be traversed outside of it
+ */
+template<IsDim auto Dim, IsDim auto DimMajor, IsDim auto DimMinor, class T, class MinorLenT>
+struct into_blocks_clamped_t : strict_contain<T, MinorLenT> {
+	using strict_contain<T, MinorLenT>::strict_contain;
+
+	static constexpr char name[] = "into_blocks_clamped_t";
+	using params = struct_params<
+		dim_param<Dim>,
+		dim_param<DimMajor>,
+		dim_param<DimMinor>,
+		structure_param<T>,
+		type_param<MinorLenT>>;
+
+	constexpr T sub_structure() const noexcept { return this->template get<0>(); }
+	constexpr MinorLenT minor_length() const noexcept { return this->template get<1>(); }
+
+	static_assert(DimMajor != DimMinor, "Cannot use the same name for two components of a dimension");
+	static_assert(DimMajor == Dim || !T::signature::template any_accept<DimMajor>, "Dimension of this name already exists");
+	static_assert(DimMinor == Dim || !T::signature::template any_accept<DimMinor>, "Dimension of this name already exists");
+private:
+	template<class Original>
+	struct dim_replacement {
+		static_assert(!Original::dependent, "Cannot split a tuple index into blocks");
+		static_assert(Original::arg_length::is_known, "Length of the dimension to be split must be set before splitting");
+		template<class, class>
+		struct lengths {
+			using major = dynamic_arg_length;
+			using minor = dynamic_arg_length;
+		};
+		template<std::size_t Num, std::size_t Denom>
+		struct lengths<static_arg_length<Num>, static_arg_length<Denom>> {
+			using major = static_arg_length<(Num + Denom - 1) / Denom>;
+			using minor = std::conditional_t<Num % Denom == 0, static_arg_length<Denom>, dynamic_arg_length>;
+		};
+		using l = lengths<typename Original::arg_length, arg_length_from_t<MinorLenT>>;
+		using type = function_sig<DimMajor, typename l::major, function_sig<DimMinor, typename l::minor, typename Original::ret_sig>>;
+	};
+
+	// whether all the blocks are full, i.e. the minor length is static (see `dim_replacement`)
+	template<class FullLength>
+	static constexpr bool full_blocks = [] {
+		if constexpr(std::is_empty_v<FullLength> && std::is_empty_v<MinorLenT>)
+			return FullLength::value % MinorLenT::value == 0;
+		else
+			return false;
+	}();
+public:
+	using signature = typename T::signature::template replace<dim_replacement, Dim>;
+
+	template<IsState State>
+	constexpr auto sub_state(State state) const noexcept {
+		static_assert(!State::template contains<length_in<DimMajor>>, "This dimension cannot be resized");
+		static_assert(!State::template contains<length_in<DimMinor>>, "This dimension cannot be resized");
+		const auto clean_state = state.template remove<index_in<Dim>, length_in<Dim>, index_in<DimMajor>, index_in<DimMinor>>();
+		if constexpr(State::template contains<index_in<DimMajor>> && State::template contains<index_in<DimMinor>>) {
+			const auto major_index = state.template get<index_in<DimMajor>>();
+			const auto minor_index = state.template get<index_in<DimMinor>>();
+			return clean_state.template with<index_in<Dim>>(major_index*minor_length() + minor_index);
+		} else {
+			return clean_state;
+		}
+	}
+
+	constexpr auto size(IsState auto state) const noexcept {
+		return sub_structure().size(sub_state(state));
+	}
+
+	template<class Sub>
+	constexpr auto strict_offset_of(IsState auto state) const noexcept {
+		return offset_of<Sub>(sub_structure(), sub_state(state));
+	}
+
+	template<auto QDim, IsState State> requires IsDim<decltype(QDim)>
+	constexpr auto length(State state) const noexcept {
+		using namespace constexpr_arithmetic;
+		static_assert(!State::template contains<index_in<QDim>>, "This dimension is already fixed, it cannot be used from outside");
+		if constexpr(QDim == DimMinor) {
+			using full_length_t = decltype(sub_structure().template length<Dim>(sub_state(state)));
+			if constexpr(full_blocks<full_length_t>) {
+				// all the blocks are full (the length is static, as in the signature)
+				return minor_length();
+			} else {
+				static_assert(State::template contains<index_in<DimMajor>>, "Fix block index before querying this dimension (or pass the index in state)");
+				const std::size_t full_length = sub_structure().template length<Dim>(sub_state(state));
+				const std::size_t first = state.template get<index_in<DimMajor>>() * minor_length();
+				return full_length - first < std::size_t(minor_length()) ? full_length - first : std::size_t(minor_length());
+			}
+		} else if constexpr(QDim == DimMajor) {
+			const auto full_length = sub_structure().template length<Dim>(sub_state(state));
+			return (full_length + minor_length() - make_const<1>()) / minor_length();
+		} else {
+			static_assert(QDim != Dim, "Index in this dimension is overriden by a substructure");
+			return sub_structure().template length<QDim>(sub_state(state));
+		}
+	}
+
+	template<class Sub>
+	constexpr auto strict_state_at(IsState auto state) const noexcept {
+		return state_at<Sub>(sub_structure(), sub_state(state));
+	}
+};
+
+template<IsDim auto Dim, IsDim auto DimMajor, IsDim auto DimMinor, class MinorLenT>
+struct into_blocks_clamped_proto : strict_contain<MinorLenT> {
+	using strict_contain<MinorLenT>::strict_contain;
+
+	static constexpr bool proto_preserves_layout = true;
+
+	template<class Struct>
+	constexpr auto instantiate_and_construct(Struct s) const noexcept { return into_blocks_clamped_t<Dim, DimMajor, DimMinor, Struct, MinorLenT>(s, this->get()); }
+};
+
+template<IsDim auto Dim, IsDim auto DimMajor, IsDim auto DimMinor = Dim, class MinorLenT>
+constexpr auto into_blocks_clamped(MinorLenT minor_length) {
+	return into_blocks_clamped_proto<Dim, DimMajor, DimMinor, good_index_t<MinorLenT>>(minor_length);
+}
+
+namespace helpers {
+
+// the divisor of the merged indices: the minor length itself if it is static, otherwise a `fast_divisor` precomputed for it
+template<IsDim auto DimMinor, class T>
+struct merge_blocks_divisor {
+	using length_t = decltype(std::declval<T>().template length<DimMinor>(empty_state));
+	using type = std::conditional_t<std::is_empty_v<length_t>, length_t, fast_divisor>;
+
+	static constexpr type make(const T &sub_structure) noexcept {
+		return type(sub_structure.template length<DimMinor>(empty_state));
+	}
+};
+
+} // namespace helpers
+
+/**
+ * @brief merges the dimensions `DimMajor` and `DimMinor` into `Dim` (the index `major * minor_length + minor`)
+ *
+ * The length of `DimMinor` is read (and, if it is dynamic, the magic multiplier for dividing the merged indices by it
+ * is precomputed, see `fast_divisor`) when the structure is constructed, so it must not depend on the indices in other dimensions.
+ */
 template<IsDim auto DimMajor, IsDim auto DimMinor, IsDim auto Dim, class T>
-struct merge_blocks_t : strict_contain<T> {
-	using strict_contain<T>::strict_contain;
+struct merge_blocks_t : strict_contain<T, typename helpers::merge_blocks_divisor<DimMinor, T>::type> {
+	using base = strict_contain<T, typename helpers::merge_blocks_divisor<DimMinor, T>::type>;
+
+	constexpr merge_blocks_t() noexcept = default;
+	explicit constexpr merge_blocks_t(T sub_structure) noexcept : base(sub_structure, helpers::merge_blocks_divisor<DimMinor, T>::make(sub_structure)) {}
 
 	static constexpr char name[] = "merge_blocks_t";
 	using params = struct_params<
@@ -384,7 +531,8 @@ struct merge_blocks_t : strict_contain<T> {
 		dim_param<Dim>,
 		structure_param<T>>;
 
-	constexpr T sub_structure() const noexcept { return this->get(); }
+	constexpr T sub_structure() const noexcept { return this->template get<0>(); }
+	constexpr auto minor_divisor() const noexcept { return this->template get<1>(); }
 
 	static_assert(DimMajor != DimMinor, "Cannot merge a dimension with itself");
 	static_assert(Dim == DimMajor || Dim == DimMinor || !T::signature::template any_accept<Dim>, "Dimension of this name already exists");
@@ -422,19 +570,21 @@ public:
 		using namespace constexpr_arithmetic;
 		const auto clean_state = state.template remove<index_in<Dim>, length_in<Dim>, index_in<DimMajor>, length_in<DimMajor>, index_in<DimMinor>, length_in<DimMinor>>();
 		const auto minor_length = sub_structure().template length<DimMinor>(clean_state);
+		if constexpr(!std::is_empty_v<decltype(minor_divisor())>)
+			assert(minor_divisor().divisor == std::size_t(minor_length) && "The minor length must not depend on the other indices");
 		if constexpr(State::template contains<length_in<Dim>>) {
 			const auto dim_length = state.template get<length_in<Dim>>();
 			const auto major_length = dim_length / minor_length;
 			if constexpr(State::template contains<index_in<Dim>>) {
-				const auto index = state.template get<index_in<Dim>>();
-				return clean_state.template with<index_in<DimMajor>, index_in<DimMinor>, length_in<DimMajor>>(index / minor_length, index % minor_length, major_length);
+				const auto [major_index, minor_index] = div_mod(state.template get<index_in<Dim>>(), minor_divisor());
+				return clean_state.template with<index_in<DimMajor>, index_in<DimMinor>, length_in<DimMajor>>(major_index, minor_index, major_length);
 			} else {
 				return clean_state.template with<length_in<DimMajor>>(major_length);
 			}
 		} else {
 			if constexpr(State::template contains<index_in<Dim>>) {
-				const auto index = state.template get<index_in<Dim>>();
-				return clean_state.template with<index_in<DimMajor>, index_in<DimMinor>>(index / minor_length, index % minor_length);
+				const auto [major_index, minor_index] = div_mod(state.template get<index_in<Dim>>(), minor_divisor());
+				return clean_state.template with<index_in<DimMajor>, index_in<DimMinor>>(major_index, minor_index);
 			} else {
 				return clean_state;
 			}
@@ -458,7 +608,14 @@ public:
 			if constexpr(State::template contains<length_in<Dim>>) {
 				return state.template get<length_in<Dim>>();
 			} else {
-				return sub_structure().template length<DimMajor>(sub_state(state)) * sub_structure().template length<DimMinor>(sub_state(state));
+				const auto major_length = sub_structure().template length<DimMajor>(sub_state(state));
+				const auto minor_length = sub_structure().template length<DimMinor>(sub_state(state));
+				if constexpr(std::is_empty_v<decltype(major_length)> && std::is_empty_v<decltype(minor_length)>) {
+					return major_length * minor_length;
+				} else {
+					// the product of two (e.g. 32-bit) lengths is computed in `std::size_t`, it need not fit in their type
+					return std::size_t(major_length) * std::size_t(minor_length);
+				}
 			}
 		} else {
 			return sub_structure().template length<QDim>(sub_state(state));
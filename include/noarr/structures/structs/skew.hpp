@@ -0,0 +1,158 @@
+#ifndef NOARR_STRUCTURES_SKEW_HPP
+#define NOARR_STRUCTURES_SKEW_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "../base/contain.hpp"
+#include "../base/signature.hpp"
+#include "../base/state.hpp"
+#include "../base/structs_common.hpp"
+#include "../base/utility.hpp"
+
+namespace noarr {
+
+/**
+ * @brief skews the dimensions `DimA` and `DimB` into a wavefront dimension `DimWave` (with index `factor * a + b`)
+ * and a dimension `DimPos` enumerating the elements of a wavefront (in the increasing order of `a`)
+ *
+ * If each element depends only on elements with a lower wavefront index (e.g. for dependence distances (1, *) and (0, 1)
+ * with `factor` at least one more than the largest negative `b` distance), the elements of a single wavefront are independent.
+ */
+template<IsDim auto DimA, IsDim auto DimB, IsDim auto DimWave, IsDim auto DimPos, class T, class FactorT>
+struct skew_t : strict_contain<T, FactorT> {
+	using strict_contain<T, FactorT>::strict_contain;
+
+	static constexpr char name[] = "skew_t";
+	using params = struct_params<
+		dim_param<DimA>,
+		dim_param<DimB>,
+		dim_param<DimWave>,
+		dim_param<DimPos>,
+		structure_param<T>,
+		type_param<FactorT>>;
+
+	constexpr T sub_structure() const noexcept { return this->template get<0>(); }
+	constexpr FactorT factor() const noexcept { return this->template get<1>(); }
+
+	static_assert(DimA != DimB, "Cannot skew a dimension with itself");
+	static_assert(DimWave != DimPos, "Cannot use the same name for two components of a dimension");
+	static_assert(DimWave == DimA || DimWave == DimB || !T::signature::template any_accept<DimWave>, "Dimension of this name already exists");
+	static_assert(DimPos == DimA || DimPos == DimB || !T::signature::template any_accept<DimPos>, "Dimension of this name already exists");
+private:
+	template<class Original>
+	struct outer_dim_replacement {
+		static_assert(!Original::dependent, "Cannot skew a tuple index");
+		static_assert(Original::arg_length::is_known, "The length of a skewed dimension must be set before skewing");
+		template<class OriginalInner>
+		struct inner_dim_replacement {
+			static_assert(!OriginalInner::dependent, "Cannot skew a tuple index");
+			static_assert(OriginalInner::arg_length::is_known, "The length of a skewed dimension must be set before skewing");
+			using type = typename OriginalInner::ret_sig;
+		};
+
+		using ret_sig = typename Original::ret_sig::template replace<inner_dim_replacement, DimA, DimB>;
+		using type = function_sig<DimWave, dynamic_arg_length, function_sig<DimPos, dynamic_arg_length, ret_sig>>;
+	};
+
+	template<IsState State>
+	constexpr auto clean_state(State state) const noexcept {
+		static_assert(!State::template contains<length_in<DimWave>>, "This dimension cannot be resized");
+		static_assert(!State::template contains<length_in<DimPos>>, "This dimension cannot be resized");
+		return state.template remove<index_in<DimWave>, index_in<DimPos>, index_in<DimA>, length_in<DimA>, index_in<DimB>, length_in<DimB>>();
+	}
+public:
+	using signature = typename T::signature::template replace<outer_dim_replacement, DimA, DimB>;
+
+	/**
+	 * @brief returns the range of indices in `DimA` covered by the wavefront `wave` as the pair (first index, length)
+	 */
+	template<IsState State>
+	constexpr auto wave_range(State state, std::size_t wave) const noexcept {
+		const auto clean = clean_state(state);
+		const std::size_t len_a = sub_structure().template length<DimA>(clean);
+		const std::size_t len_b = sub_structure().template length<DimB>(clean);
+		const std::size_t f = factor();
+
+		const std::size_t first = wave < len_b ? 0 : (wave - len_b + f) / f;
+		const std::size_t last = wave / f < len_a ? wave / f + 1 : len_a;
+
+		return std::pair<std::size_t, std::size_t>(first, first < last ? last - first : 0);
+	}
+
+	template<IsState State>
+	constexpr auto sub_state(State state) const noexcept {
+		const auto clean = clean_state(state);
+		if constexpr(State::template contains<index_in<DimWave>> && State::template contains<index_in<DimPos>>) {
+			const std::size_t wave = state.template get<index_in<DimWave>>();
+			const std::size_t pos = state.template get<index_in<DimPos>>();
+			const std::size_t index_a = wave_range(state, wave).first + pos;
+			const std::size_t index_b = wave - std::size_t(factor()) * index_a;
+			return clean.template with<index_in<DimA>, index_in<DimB>>(index_a, index_b);
+		} else {
+			return clean;
+		}
+	}
+
+	constexpr auto size(IsState auto state) const noexcept {
+		return sub_structure().size(sub_state(state));
+	}
+
+	template<class Sub>
+	constexpr auto strict_offset_of(IsState auto state) const noexcept {
+		return offset_of<Sub>(sub_structure(), sub_state(state));
+	}
+
+	template<auto QDim, IsState State> requires IsDim<decltype(QDim)>
+	constexpr auto length(State state) const noexcept {
+		static_assert(!State::template contains<index_in<QDim>>, "This dimension is already fixed, it cannot be used from outside");
+		if constexpr(QDim == DimWave) {
+			const auto clean = clean_state(state);
+			const std::size_t len_a = sub_structure().template length<DimA>(clean);
+			const std::size_t len_b = sub_structure().template length<DimB>(clean);
+			return len_a == 0 || len_b == 0 ? std::size_t(0) : std::size_t(factor()) * (len_a - 1) + len_b;
+		} else if constexpr(QDim == DimPos) {
+			static_assert(State::template contains<index_in<DimWave>>, "Fix the wavefront index before querying this dimension (or pass the index in state)");
+			return wave_range(state, state.template get<index_in<DimWave>>()).second;
+		} else {
+			static_assert(QDim != DimA && QDim != DimB, "Index in this dimension is overriden by a substructure");
+			return sub_structure().template length<QDim>(sub_state(state));
+		}
+	}
+
+	template<class Sub>
+	constexpr auto strict_state_at(IsState auto state) const noexcept {
+		return state_at<Sub>(sub_structure(), sub_state(state));
+	}
+};
+
+template<IsDim auto DimA, IsDim auto DimB, IsDim auto DimWave, IsDim auto DimPos, class FactorT>
+struct skew_proto : strict_contain<FactorT> {
+	using strict_contain<FactorT>::strict_contain;
+
+	static constexpr bool proto_preserves_layout = true;
+
+	template<class Struct>
+	constexpr auto instantiate_and_construct(Struct s) const noexcept { return skew_t<DimA, DimB, DimWave, DimPos, Struct, FactorT>(s, this->get()); }
+};
+
+/**
+ * @brief skews the dimensions `DimA` and `DimB` into wavefronts (see `skew_t`); after the transformation,
+ * the dimension `DimWave` enumerates the wavefronts and `DimPos` the (mutually independent) elements within a wavefront
+ *
+ * @param factor: the skewing factor (the wavefront index is `factor * a + b`)
+ */
+template<IsDim auto DimA, IsDim auto DimB, IsDim auto DimWave = DimA, IsDim auto DimPos = DimB, class FactorT>
+constexpr auto skew(FactorT factor) noexcept {
+	return skew_proto<DimA, DimB, DimWave, DimPos, good_index_t<FactorT>>(factor);
+}
+
+template<IsDim auto DimA, IsDim auto DimB, IsDim auto DimWave = DimA, IsDim auto DimPos = DimB>
+constexpr auto skew() noexcept {
+	return skew<DimA, DimB, DimWave, DimPos>(lit<1>);
+}
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_SKEW_HPP
@@ -0,0 +1,176 @@
+#ifndef NOARR_STRUCTURES_TIME_TILES_HPP
+#define NOARR_STRUCTURES_TIME_TILES_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "../base/contain.hpp"
+#include "../base/signature.hpp"
+#include "../base/state.hpp"
+#include "../base/structs_common.hpp"
+#include "../base/utility.hpp"
+
+namespace noarr {
+
+/**
+ * @brief tiles a time dimension `DimT` together with a space dimension `DimS` into parallelogram tiles:
+ * tile (`DimTT`, `DimST`) covers `time_block` consecutive time steps and, in each of them, the `space_block` indices `s`
+ * for which `s + slope * t` falls into the `DimST`-th block (the tiles are skewed against the flow of time)
+ *
+ * The dimension `DimT` then enumerates the time steps within a tile and `DimS` the indices within the tile's row.
+ * The state of the structure below (e.g. the state of a traverser, `get_index<DimT>(inner)`) has the global time step
+ * (`DimTT * time_block + DimT`), so that e.g. the parity of a step does not depend on the tile size.
+ * If each time step depends only on the previous ones within the distance `slope` in `DimS`, traversing the tiles
+ * in the lexicographic order preserves all dependences and the tiles on an anti-diagonal (see `skew<DimTT, DimST>`) are independent.
+ */
+template<IsDim auto DimT, IsDim auto DimS, IsDim auto DimTT, IsDim auto DimST, class T, class TimeBlockT, class SpaceBlockT, class SlopeT>
+struct time_tiles_t : strict_contain<T, TimeBlockT, SpaceBlockT, SlopeT> {
+	using strict_contain<T, TimeBlockT, SpaceBlockT, SlopeT>::strict_contain;
+
+	static constexpr char name[] = "time_tiles_t";
+	using params = struct_params<
+		dim_param<DimT>,
+		dim_param<DimS>,
+		dim_param<DimTT>,
+		dim_param<DimST>,
+		structure_param<T>,
+		type_param<TimeBlockT>,
+		type_param<SpaceBlockT>,
+		type_param<SlopeT>>;
+
+	constexpr T sub_structure() const noexcept { return this->template get<0>(); }
+	constexpr TimeBlockT time_block() const noexcept { return this->template get<1>(); }
+	constexpr SpaceBlockT space_block() const noexcept { return this->template get<2>(); }
+	constexpr SlopeT slope() const noexcept { return this->template get<3>(); }
+
+	static_assert(DimT != DimS, "Cannot tile a dimension with itself");
+	static_assert(DimTT != DimST, "Cannot use the same name for two components of a dimension");
+	static_assert(DimTT != DimT && DimTT != DimS && !T::signature::template any_accept<DimTT>, "Dimension of this name already exists");
+	static_assert(DimST != DimT && DimST != DimS && !T::signature::template any_accept<DimST>, "Dimension of this name already exists");
+private:
+	template<class Original>
+	struct outer_dim_replacement {
+		static_assert(!Original::dependent, "Cannot tile a tuple index");
+		static_assert(Original::dim == DimT, "The time dimension must be traversed outside of the space dimension");
+		static_assert(Original::arg_length::is_known, "The length of the time dimension must be set before tiling");
+		template<class OriginalInner>
+		struct inner_dim_replacement {
+			static_assert(!OriginalInner::dependent, "Cannot tile a tuple index");
+			static_assert(OriginalInner::arg_length::is_known, "The length of the space dimension must be set before tiling");
+			using type = function_sig<DimS, dynamic_arg_length, typename OriginalInner::ret_sig>;
+		};
+
+		using ret_sig = typename Original::ret_sig::template replace<inner_dim_replacement, DimS>;
+		using type = function_sig<DimTT, dynamic_arg_length, function_sig<DimST, dynamic_arg_length, function_sig<DimT, dynamic_arg_length, ret_sig>>>;
+	};
+
+	template<IsState State>
+	static constexpr auto clean_state(State state) noexcept {
+		static_assert(!State::template contains<length_in<DimTT>>, "This dimension cannot be resized");
+		static_assert(!State::template contains<length_in<DimST>>, "This dimension cannot be resized");
+		return state.template remove<index_in<DimTT>, index_in<DimST>, index_in<DimT>, length_in<DimT>, index_in<DimS>, length_in<DimS>>();
+	}
+
+	// the first time step of the tile and the number of time steps in it
+	template<IsState State>
+	constexpr std::pair<std::size_t, std::size_t> time_range(State state) const noexcept {
+		const std::size_t len_t = sub_structure().template length<DimT>(clean_state(state));
+		const std::size_t first = std::size_t(state.template get<index_in<DimTT>>()) * std::size_t(time_block());
+		return {first, len_t - first < std::size_t(time_block()) ? len_t - first : std::size_t(time_block())};
+	}
+
+	// the first space index of the tile's row (at the global time step `t`) and the number of indices in it
+	template<IsState State>
+	constexpr std::pair<std::size_t, std::size_t> space_range(State state, std::size_t t) const noexcept {
+		const std::size_t len_s = sub_structure().template length<DimS>(clean_state(state));
+		const std::size_t shift = t * std::size_t(slope());
+		const std::size_t begin = std::size_t(state.template get<index_in<DimST>>()) * std::size_t(space_block());
+		const std::size_t end = begin + std::size_t(space_block());
+		const std::size_t first = begin < shift ? 0 : begin - shift;
+		const std::size_t last = end < shift ? 0 : end - shift < len_s ? end - shift : len_s;
+		return {first, first < last ? last - first : 0};
+	}
+public:
+	using signature = typename T::signature::template replace<outer_dim_replacement, DimT, DimS>;
+
+	template<IsState State>
+	constexpr auto sub_state(State state) const noexcept {
+		const auto clean = clean_state(state);
+		if constexpr(State::template contains<index_in<DimTT>> && State::template contains<index_in<DimT>>) {
+			const std::size_t t = time_range(state).first + state.template get<index_in<DimT>>();
+			if constexpr(State::template contains<index_in<DimST>> && State::template contains<index_in<DimS>>) {
+				const std::size_t s = space_range(state, t).first + state.template get<index_in<DimS>>();
+				return clean.template with<index_in<DimT>, index_in<DimS>>(t, s);
+			} else {
+				return clean.template with<index_in<DimT>>(t);
+			}
+		} else {
+			return clean;
+		}
+	}
+
+	constexpr auto size(IsState auto state) const noexcept {
+		return sub_structure().size(sub_state(state));
+	}
+
+	template<class Sub>
+	constexpr auto strict_offset_of(IsState auto state) const noexcept {
+		return offset_of<Sub>(sub_structure(), sub_state(state));
+	}
+
+	template<auto QDim, IsState State> requires IsDim<decltype(QDim)>
+	constexpr auto length(State state) const noexcept {
+		static_assert(!State::template contains<index_in<QDim>>, "This dimension is already fixed, it cannot be used from outside");
+		if constexpr(QDim == DimTT) {
+			const std::size_t len_t = sub_structure().template length<DimT>(clean_state(state));
+			return (len_t + std::size_t(time_block()) - 1) / std::size_t(time_block());
+		} else if constexpr(QDim == DimST) {
+			const std::size_t len_t = sub_structure().template length<DimT>(clean_state(state));
+			const std::size_t len_s = sub_structure().template length<DimS>(clean_state(state));
+			return len_t == 0 || len_s == 0 ? std::size_t(0) : (len_s - 1 + (len_t - 1) * std::size_t(slope())) / std::size_t(space_block()) + 1;
+		} else if constexpr(QDim == DimT) {
+			static_assert(State::template contains<index_in<DimTT>>, "Fix the time tile index before querying this dimension (or pass the index in state)");
+			return time_range(state).second;
+		} else if constexpr(QDim == DimS) {
+			static_assert(State::template contains<index_in<DimTT>> && State::template contains<index_in<DimST>>, "Fix the tile indices before querying this dimension (or pass the indices in state)");
+			static_assert(State::template contains<index_in<DimT>>, "Fix the time step before querying this dimension (or pass the index in state)");
+			return space_range(state, time_range(state).first + state.template get<index_in<DimT>>()).second;
+		} else {
+			return sub_structure().template length<QDim>(sub_state(state));
+		}
+	}
+
+	template<class Sub>
+	constexpr auto strict_state_at(IsState auto state) const noexcept {
+		return state_at<Sub>(sub_structure(), sub_state(state));
+	}
+};
+
+template<IsDim auto DimT, IsDim auto DimS, IsDim auto DimTT, IsDim auto DimST, class TimeBlockT, class SpaceBlockT, class SlopeT>
+struct time_tiles_proto : strict_contain<TimeBlockT, SpaceBlockT, SlopeT> {
+	using strict_contain<TimeBlockT, SpaceBlockT, SlopeT>::strict_contain;
+
+	static constexpr bool proto_preserves_layout = true;
+
+	template<class Struct>
+	constexpr auto instantiate_and_construct(Struct s) const noexcept {
+		return time_tiles_t<DimT, DimS, DimTT, DimST, Struct, TimeBlockT, SpaceBlockT, SlopeT>(s, this->template get<0>(), this->template get<1>(), this->template get<2>());
+	}
+};
+
+/**
+ * @brief tiles the time dimension `DimT` and the space dimension `DimS` into parallelogram tiles indexed by `DimTT` and `DimST` (see `time_tiles_t`)
+ *
+ * @param time_block: the number of time steps in a tile
+ * @param space_block: the width of a tile (in `DimS`)
+ * @param slope: the skew of the tiles per time step (the largest distance in `DimS` a time step depends on)
+ */
+template<IsDim auto DimT, IsDim auto DimS, IsDim auto DimTT, IsDim auto DimST, class TimeBlockT, class SpaceBlockT, class SlopeT = lit_t<1>>
+constexpr auto time_tiles(TimeBlockT time_block, SpaceBlockT space_block, SlopeT slope = {}) noexcept {
+	return time_tiles_proto<DimT, DimS, DimTT, DimST, good_index_t<TimeBlockT>, good_index_t<SpaceBlockT>, good_index_t<SlopeT>>(time_block, space_block, slope);
+}
+
+} // namespace noarr
+
+#endif // NOARR_STRUCTURES_TIME_TILES_HPP
@@ -8,7 +8,10 @@
 #include "structures.hpp"
 
 #include "structures/extra/shortcuts.hpp"
+#include "structures/extra/specialize.hpp"
 #include "structures/structs/blocks.hpp"
+#include "structures/structs/skew.hpp"
+#include "structures/structs/time_tiles.hpp"
 #include "structures/structs/setters.hpp"
 #include "structures/structs/slice.hpp"
 #include "structures/structs/views.hpp"
@@ -14,6 +14,21 @@
 #include "structures/interop/traverser_iter.hpp"
 #include "structures/interop/planner_iter.hpp"
 
+#include "structures/extra/peel.hpp"
+#include "structures/extra/stencil.hpp"
+#include "structures/extra/recursive_bisect.hpp"
+#include "structures/extra/triangular.hpp"
+#include "structures/extra/fuse.hpp"
+#include "structures/extra/expr.hpp"
+#include "structures/extra/reduce.hpp"
+#include "structures/extra/auto_order.hpp"
+#include "structures/extra/invariant.hpp"
+#include "structures/extra/streaming.hpp"
+#include "structures/extra/atomic.hpp"
+#include "structures/extra/pack_tile.hpp"
+#include "structures/extra/gemm.hpp"
+#include "structures/extra/cache_tile.hpp"
+
 #include "structures/interop/serialize_data.hpp"
 
 #endif // NOARR_STRUCTURES_TRAVERSERS_HPP
@@ -0,0 +1,97 @@
+#include <noarr_test/macros.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("Atomic accesses", "[atomic]") {
+	auto data = make_bag(scalar<int>() ^ vector<'i'>(8));
+	traverser(data) | [&](auto state) { data[state] = 10; };
+
+	auto a = atomic(data);
+	auto elem = a[idx<'i'>(3)];
+
+	REQUIRE((elem += 5) == 15);
+	REQUIRE((elem -= 2) == 13);
+	REQUIRE(elem.fetch_add(1) == 13);
+	REQUIRE(elem.fetch_min(20) == 14);
+	REQUIRE(elem.load() == 14);
+	REQUIRE(elem.fetch_min(4) == 14);
+	REQUIRE(elem.fetch_max(3) == 4);
+	REQUIRE(elem.fetch_max(9) == 4);
+	REQUIRE(elem.exchange(7) == 9);
+	elem = 1;
+	REQUIRE(int(elem) == 1);
+
+	REQUIRE(data[idx<'i'>(3)] == 1);
+	REQUIRE(data[idx<'i'>(2)] == 10);
+	REQUIRE(a.data() == data.data());
+	REQUIRE((a | get_length<'i'>()) == 8);
+}
+
+TEST_CASE("Atomic accesses with a read-modify-write order", "[atomic]") {
+	auto data = make_bag(scalar<long>() ^ vector<'i'>(4));
+	traverser(data) | [&](auto state) { data[state] = 0; };
+
+	// the loads and stores use the acquire and release parts of the order
+	STATIC_REQUIRE(helpers::atomic_load_order(std::memory_order_acq_rel) == std::memory_order_acquire);
+	STATIC_REQUIRE(helpers::atomic_load_order(std::memory_order_release) == std::memory_order_relaxed);
+	STATIC_REQUIRE(helpers::atomic_load_order(std::memory_order_seq_cst) == std::memory_order_seq_cst);
+	STATIC_REQUIRE(helpers::atomic_store_order(std::memory_order_acq_rel) == std::memory_order_release);
+	STATIC_REQUIRE(helpers::atomic_store_order(std::memory_order_acquire) == std::memory_order_relaxed);
+	STATIC_REQUIRE(helpers::atomic_store_order(std::memory_order_seq_cst) == std::memory_order_seq_cst);
+
+	auto a = atomic(data, std::memory_order_acq_rel);
+	traverser(a) | [&](auto state) {
+		a[state] += long(get_index<'i'>(state));
+		a[state] = a[state] * 2;
+		REQUIRE(a[state].load() == long(2 * get_index<'i'>(state)));
+	};
+}
+
+TEST_CASE("Atomic parallel histogram", "[atomic]") {
+	constexpr std::size_t num_threads = 4;
+	auto in = make_bag(scalar<unsigned>() ^ vector<'j'>(1000) ^ vector<'t'>(num_threads));
+	auto hist_data = make_bag(scalar<unsigned>() ^ vector<'v'>(16));
+	auto lo_data = make_bag(scalar<unsigned>() ^ vector<'v'>(16));
+	auto hi_data = make_bag(scalar<unsigned>() ^ vector<'v'>(16));
+
+	traverser(in) | [&](auto state) {
+		auto [t, j] = get_indices<'t', 'j'>(state);
+		in[state] = unsigned(t * 1000 + j);
+	};
+	traverser(hist_data) | [&](auto state) {
+		hist_data[state] = 0;
+		lo_data[state] = ~0u;
+		hi_data[state] = 0;
+	};
+
+	auto hist = atomic(hist_data);
+	auto lo = atomic(lo_data, std::memory_order_relaxed);
+	auto hi = atomic(hi_data, std::memory_order_seq_cst);
+
+	std::vector<std::thread> threads;
+	for (std::size_t t = 0; t < num_threads; t++)
+		threads.emplace_back([&in, hist, lo, hi, t] {
+			traverser(in) ^ fix<'t'>(t) | [&](auto state) {
+				const unsigned value = in[state];
+				const auto bin = idx<'v'>(value % 16);
+				hist[bin] += 1;
+				lo[bin].fetch_min(value);
+				hi[bin].fetch_max(value);
+			};
+		});
+	for (auto &thread : threads)
+		thread.join();
+
+	traverser(hist_data) | [&](auto state) {
+		const auto v = unsigned(get_index<'v'>(state));
+		REQUIRE(hist_data[state] == num_threads * 1000 / 16);
+		REQUIRE(lo_data[state] == v);
+		REQUIRE(hi_data[state] == num_threads * 1000 - 16 + v);
+	};
+}
@@ -0,0 +1,45 @@
+#include <noarr_test/macros.hpp>
+
+#include <sstream>
+#include <type_traits>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("Automatic order of a matrix product", "[auto_order]") {
+	auto c = scalar<float>() ^ vector<'j'>(10) ^ vector<'i'>(10);
+	auto a = scalar<float>() ^ vector<'k'>(10) ^ vector<'i'>(10);
+	auto b = scalar<float>() ^ vector<'j'>(10) ^ vector<'k'>(10);
+
+	auto t = traverser(c, a, b) ^ auto_order();
+	STATIC_REQUIRE(std::is_same_v<traversal_dims<decltype(t)>, dim_sequence<'i', 'k', 'j'>>);
+
+	std::ostringstream out;
+	print_order(out, t);
+	REQUIRE(out.str() == "'i', 'k', 'j'");
+
+	// a transposed operand changes the order
+	auto bt = scalar<float>() ^ vector<'k'>(10) ^ vector<'j'>(10);
+	auto u = traverser(c, a, bt) ^ auto_order();
+	STATIC_REQUIRE(std::is_same_v<traversal_dims<decltype(u)>, dim_sequence<'i', 'j', 'k'>>);
+
+	// pinned dimensions stay outermost
+	auto v = traverser(c, a, b) ^ auto_order<'j'>();
+	STATIC_REQUIRE(std::is_same_v<traversal_dims<decltype(v)>, dim_sequence<'j', 'i', 'k'>>);
+}
+
+TEST_CASE("Automatic order traverses everything", "[auto_order]") {
+	auto a_data = make_bag(scalar<int>() ^ vector<'i'>(4) ^ vector<'j'>(3));
+	auto a = a_data.get_ref();
+
+	auto t = traverser(a) ^ auto_order();
+	STATIC_REQUIRE(std::is_same_v<traversal_dims<decltype(t)>, dim_sequence<'j', 'i'>>);
+
+	std::size_t expected = 0;
+	t | [&](auto state) {
+		REQUIRE((a | offset(state)) == expected * sizeof(int));
+		expected++;
+	};
+	REQUIRE(expected == 12);
+}
@@ -0,0 +1,72 @@
+#include <noarr_test/macros.hpp>
+
+#include <vector>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("2.5D blocking coverage and order", "[blocking_2_5d]") {
+	auto a = scalar<int>() ^ vector<'k'>(5) ^ vector<'j'>(7) ^ vector<'i'>(10);
+
+	std::vector<int> visited(10 * 7 * 5, 0);
+	std::size_t tiles = 0;
+
+	traverser(a) ^ blocking_2_5d<'i', 'j', 'k', 'I', 'J'>(4, 3) | for_dims<'I', 'J'>([&](auto tile) {
+		tiles++;
+
+		std::size_t last_k = 0;
+		tile | [&](auto state) {
+			auto [i, j, k] = get_indices<'i', 'j', 'k'>(state);
+			REQUIRE(k >= last_k);
+			last_k = k;
+			visited[(i * 7 + j) * 5 + k]++;
+		};
+	});
+
+	REQUIRE(tiles == 3 * 3);
+	for (auto v : visited)
+		REQUIRE(v == 1);
+}
+
+TEST_CASE("2.5D blocking with merged tiles", "[blocking_2_5d]") {
+	auto a = scalar<int>() ^ vector<'k'>(5) ^ vector<'j'>(7) ^ vector<'i'>(10);
+	auto blocked = a ^ blocking_2_5d_tiles<'i', 'j', 'k', 'T'>(4, 3);
+
+	REQUIRE((blocked | get_length<'T'>()) == 3 * 3);
+
+	std::vector<int> visited(10 * 7 * 5, 0);
+	std::size_t tiles = 0;
+
+	for (auto tile : traverser(a) ^ blocking_2_5d_tiles<'i', 'j', 'k', 'T'>(4, 3)) {
+		tiles++;
+		tile | [&](auto state) {
+			auto [i, j, k] = get_indices<'i', 'j', 'k'>(state);
+			visited[(i * 7 + j) * 5 + k]++;
+		};
+	}
+
+	REQUIRE(tiles == 3 * 3);
+	for (auto v : visited)
+		REQUIRE(v == 1);
+}
+
+TEST_CASE("Clamped blocks", "[blocking_2_5d]") {
+	auto a = scalar<int>() ^ vector<'x'>(10) ^ into_blocks_clamped<'x', 'X'>(4);
+
+	REQUIRE((a | get_length<'X'>()) == 3);
+	REQUIRE((a | get_length<'x'>(idx<'X'>(0))) == 4);
+	REQUIRE((a | get_length<'x'>(idx<'X'>(2))) == 2);
+	REQUIRE((a | offset<'X', 'x'>(2, 1)) == 9 * sizeof(int));
+
+	auto b = scalar<int>() ^ vector<'x'>(lit<12>) ^ into_blocks_clamped<'x', 'X'>(lit<4>);
+	STATIC_REQUIRE(decltype(b | get_length<'X'>())::value == 3);
+	// all the blocks are full: the minor length is static (as declared by the signature), no block index is needed
+	STATIC_REQUIRE(decltype(b)::signature::ret_sig::arg_length::is_static);
+	STATIC_REQUIRE(std::is_same_v<decltype(b | get_length<'x'>()), std::integral_constant<std::size_t, 4>>);
+	STATIC_REQUIRE(std::is_same_v<decltype(b | get_length<'x'>(idx<'X'>(2))), std::integral_constant<std::size_t, 4>>);
+
+	auto c = scalar<int>() ^ vector<'x'>(lit<10>) ^ into_blocks_clamped<'x', 'X'>(lit<4>);
+	STATIC_REQUIRE(!decltype(c)::signature::ret_sig::arg_length::is_static);
+	REQUIRE((c | get_length<'x'>(idx<'X'>(2))) == 2);
+}
@@ -0,0 +1,120 @@
+#include <noarr_test/macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("Cache sizes are parsed and detected", "[cache_tile]") {
+	REQUIRE(cache_info::parse_size("48K") == 48 * 1024);
+	REQUIRE(cache_info::parse_size("8M\n") == 8 * 1024 * 1024);
+	REQUIRE(cache_info::parse_size("32768") == 32768);
+	REQUIRE(cache_info::parse_size("none") == 0);
+
+	const auto dir = std::filesystem::temp_directory_path() / "noarr_cache_tile_test";
+	const auto write = [&dir](int index, const char *level, const char *type, const char *size) {
+		const auto sub = dir / ("index" + std::to_string(index));
+		std::filesystem::create_directories(sub);
+		std::ofstream(sub / "level") << level << '\n';
+		std::ofstream(sub / "type") << type << '\n';
+		std::ofstream(sub / "size") << size << '\n';
+	};
+	write(0, "1", "Data", "16K");
+	write(1, "1", "Instruction", "64K");
+	write(2, "2", "Unified", "512K");
+
+	const auto info = cache_info::detect(dir.string());
+	std::filesystem::remove_all(dir);
+
+	REQUIRE(info.l1 == 16 * 1024);
+	REQUIRE(info.l2 == 512 * 1024);
+	REQUIRE(info.l3 == cache_info().l3);
+
+	// the sizes of the machine are detected only once
+	REQUIRE(&cache_info::detected() == &cache_info::detected());
+}
+
+TEST_CASE("Cache tiles fit into the caches", "[cache_tile]") {
+	auto c = scalar<float>() ^ vector<'j'>(100) ^ vector<'i'>(100);
+	auto a = scalar<float>() ^ vector<'k'>(100) ^ vector<'i'>(100);
+	auto b = scalar<float>() ^ vector<'j'>(100) ^ vector<'k'>(100);
+
+	using proto = cache_tile_proto<'i', 'j', 'k'>;
+	using tiled = decltype((traverser(c, a, b) ^ proto{}).top_struct());
+
+	// three 2D float tiles: 3 * 4 * 36 * 36 <= 16K < 3 * 4 * 37 * 37
+	STATIC_REQUIRE(proto::tile_side<decltype(traverser(c, a, b).top_struct())>(16 * 1024) == 36);
+	// a single 1D double tile
+	STATIC_REQUIRE(cache_tile_proto<'i'>::tile_side<decltype(scalar<double>() ^ vector<'i'>(10))>(1024) == 128);
+
+	STATIC_REQUIRE(std::is_same_v<traversal_dims<traverser_t<tiled, neutral_proto>>, dim_sequence<
+		derived_dim<'i', '3'>, derived_dim<'j', '3'>, derived_dim<'k', '3'>,
+		derived_dim<'i', '2'>, derived_dim<'j', '2'>, derived_dim<'k', '2'>,
+		derived_dim<'i', '1'>, derived_dim<'j', '1'>, derived_dim<'k', '1'>,
+		'i', 'j', 'k'>>);
+}
+
+TEST_CASE("Cache tiling traverses everything once", "[cache_tile]") {
+	auto c_data = make_bag(scalar<int>() ^ vector<'j'>(23) ^ vector<'i'>(19));
+	auto a_data = make_bag(scalar<int>() ^ vector<'k'>(17) ^ vector<'i'>(19));
+	auto c = c_data.get_ref();
+	auto a = a_data.get_ref();
+
+	traverser(c) | [&](auto state) { c[state] = 0; };
+	traverser(a) | [&](auto state) { a[state] = 1; };
+
+	// tiny caches, so that all the levels split the dimensions (the sides are 2, 4 and 8)
+	cache_info info;
+	info.l1 = 2 * 2 * 2 * sizeof(int) * 2;
+	info.l2 = 2 * 4 * 4 * sizeof(int) * 2;
+	info.l3 = 2 * 8 * 8 * sizeof(int) * 2;
+
+	std::size_t prev_i = 0, visited = 0;
+	bool tiled = false;
+	traverser(c, a) ^ cache_tile<'i', 'j', 'k'>(info) | [&](auto state) {
+		c[state] += a[state];
+		const std::size_t i = get_index<'i'>(state);
+		tiled |= i < prev_i;
+		prev_i = i;
+		visited++;
+	};
+
+	REQUIRE(visited == 19 * 23 * 17);
+	REQUIRE(tiled);
+	traverser(c) | [&](auto state) { REQUIRE(c[state] == 17); };
+}
+
+TEST_CASE("Cache tiling with disabled levels", "[cache_tile]") {
+	auto a = scalar<int>() ^ vector<'j'>(23) ^ vector<'i'>(19);
+
+	// only L2 is tiled (the side is 4): a single L3 tile, a single L1 tile in each L2 tile
+	cache_info info;
+	info.l1 = 0;
+	info.l2 = 4 * 4 * sizeof(int) * 2;
+	info.l3 = 0;
+
+	auto t = traverser(a) ^ cache_tile<'i', 'j'>(info);
+	REQUIRE((t.top_struct() | get_length<derived_dim<'i', '3'>>()) == 1);
+	REQUIRE((t.top_struct() | get_length<derived_dim<'i', '2'>>(idx<derived_dim<'i', '3'>>(0))) == 5);
+	REQUIRE((t.top_struct() | get_length<derived_dim<'j', '2'>>(idx<derived_dim<'j', '3'>>(0))) == 6);
+
+	std::size_t visited = 0;
+	t | for_dims<derived_dim<'i', '3'>, derived_dim<'j', '3'>, derived_dim<'i', '2'>, derived_dim<'j', '2'>>([&](auto tile) {
+		REQUIRE((tile.top_struct() | get_length<derived_dim<'i', '1'>>(tile.state())) == 1);
+		REQUIRE((tile.top_struct() | get_length<derived_dim<'j', '1'>>(tile.state())) == 1);
+		tile | [&](auto) { visited++; };
+	});
+	REQUIRE(visited == 19 * 23);
+
+	// no level is tiled: a single tile of the whole structure
+	std::size_t i_prev = 0;
+	bool ordered = true;
+	traverser(a) ^ cache_tile<'i', 'j'>(cache_info{0, 0, 0}) | [&](auto state) {
+		ordered &= get_index<'i'>(state) >= i_prev;
+		i_prev = get_index<'i'>(state);
+	};
+	REQUIRE(ordered);
+}
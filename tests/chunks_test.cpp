@@ -0,0 +1,80 @@
+#include <noarr_test/macros.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <span>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("Chunks of a matrix", "[chunks]") {
+	auto a_data = make_bag(scalar<int>() ^ vector<'j'>(5) ^ vector<'i'>(4));
+	auto b_data = make_bag(scalar<int>() ^ vector<'j'>(5) ^ vector<'i'>(4));
+	auto a = a_data.get_ref();
+	auto b = b_data.get_ref();
+
+	traverser(a) | [&](auto state) {
+		auto [i, j] = get_indices<'i', 'j'>(state);
+		a[state] = (int)(i * 10 + j);
+	};
+
+	auto rows = traverser(a).chunks<'j'>(a);
+	REQUIRE(rows.size() == 4);
+
+	std::size_t i = 0;
+	for (std::span<int> row : rows) {
+		REQUIRE(row.size() == 5);
+		REQUIRE(std::accumulate(row.begin(), row.end(), 0) == (int)(5 * i * 10 + 10));
+		i++;
+	}
+
+	// several bags at once, on a part of the traversal
+	for (auto [a_row, b_row] : traverser(a, b).chunks<'j'>(a, b))
+		std::transform(a_row.begin(), a_row.end(), b_row.begin(), [](int x) { return 2 * x; });
+
+	traverser(a, b) | [&](auto state) {
+		REQUIRE(b[state] == 2 * a[state]);
+	};
+
+	auto part = (traverser(a) ^ slice<'i'>(1, 2) ^ span<'j'>(1, 4)).chunks<'j'>(a);
+	REQUIRE(part.size() == 2);
+	REQUIRE(part[0].size() == 3);
+	REQUIRE(part[0][0] == 11);
+	REQUIRE(part[1][2] == 23);
+}
+
+TEST_CASE("Chunks of an ordered matrix", "[chunks]") {
+	auto a_data = make_bag(scalar<int>() ^ vector<'j'>(6) ^ vector<'i'>(4));
+	auto a = a_data.get_ref();
+
+	traverser(a) | [&](auto state) {
+		auto [i, j] = get_indices<'i', 'j'>(state);
+		a[state] = (int)(i * 10 + j);
+	};
+
+	// a slice of the chunked dimension
+	auto sliced = (traverser(a) ^ slice<'j'>(2, 3)).chunks<'j'>(a);
+	REQUIRE(sliced.size() == 4);
+	REQUIRE(sliced[1].size() == 3);
+	REQUIRE(sliced[1][0] == 12);
+	REQUIRE(sliced[1][2] == 14);
+
+	// a step and a reversal of the other dimension
+	auto stepped = (traverser(a) ^ step<'i'>(1, 2)).chunks<'j'>(a);
+	REQUIRE(stepped.size() == 2);
+	REQUIRE(stepped[0][0] == 10);
+	REQUIRE(stepped[1][5] == 35);
+
+	auto reversed = (traverser(a) ^ reverse<'i'>()).chunks<'j'>(a);
+	REQUIRE(reversed.size() == 4);
+	REQUIRE(reversed[0].size() == 6);
+	REQUIRE(reversed[0][0] == 30);
+	REQUIRE(reversed[3][5] == 5);
+
+	// a step or a reversal of the chunked dimension is rejected (the chunks would not be contiguous)
+	STATIC_REQUIRE(helpers::chunk_order_contiguous<'j', decltype(neutral_proto() ^ slice<'j'>(2, 3))>::value);
+	STATIC_REQUIRE(!helpers::chunk_order_contiguous<'j', decltype(neutral_proto() ^ step<'j'>(0, 2))>::value);
+	STATIC_REQUIRE(!helpers::chunk_order_contiguous<'j', decltype(neutral_proto() ^ reverse<'j'>())>::value);
+	STATIC_REQUIRE(!helpers::chunk_order_contiguous<'j', decltype(neutral_proto() ^ slice<'j'>(2, 3) ^ reverse<'j'>())>::value);
+}
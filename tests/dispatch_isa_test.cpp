@@ -0,0 +1,33 @@
+#include <noarr_test/macros.hpp>
+
+#include <noarr/traversers.hpp>
+#include <noarr/structures/interop/dispatch_isa.hpp>
+
+using namespace noarr;
+
+TEST_CASE("ISA dispatch runs the kernel", "[dispatch_isa]") {
+	auto x_data = make_bag(scalar<float>() ^ vector<'i'>(1000));
+	auto y_data = make_bag(scalar<float>() ^ vector<'i'>(1000));
+	auto x = x_data.get_ref();
+	auto y = y_data.get_ref();
+
+	traverser(x) | [&](auto state) {
+		x[state] = float(get_index<'i'>(state));
+		y[state] = 1;
+	};
+
+	dispatch_isa([](auto x, auto y, float a) {
+		traverser(x, y) | [=](auto state) { y[state] += a * x[state]; };
+	}, x, y, 2.0f);
+
+	traverser(y) | [&](auto state) {
+		REQUIRE(y[state] == 1 + 2 * float(get_index<'i'>(state)));
+	};
+
+	const float sum = dispatch_isa([](auto y) {
+		float sum = 0;
+		traverser(y) | [&](auto state) { sum += y[state]; };
+		return sum;
+	}, y);
+	REQUIRE(sum == 1000 + 999 * 1000);
+}
@@ -0,0 +1,67 @@
+#include <noarr_test/macros.hpp>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("Element-wise expressions", "[expr]") {
+	auto a_data = make_bag(scalar<int>() ^ vector<'j'>(4) ^ vector<'i'>(3));
+	auto b_data = make_bag(scalar<int>() ^ vector<'i'>(3) ^ vector<'j'>(4));
+	auto c_data = make_bag(scalar<int>() ^ vector<'j'>(4) ^ vector<'i'>(3));
+	auto a = a_data.get_ref();
+	auto b = b_data.get_ref();
+	auto c = c_data.get_ref();
+
+	traverser(a, b) | [&](auto state) {
+		auto [i, j] = get_indices<'i', 'j'>(state);
+		a[state] = (int)(i + 10 * j);
+		b[state] = (int)(i * j);
+	};
+
+	expr(c) = 2 * expr(a) - b;
+
+	traverser(c) | [&](auto state) {
+		REQUIRE(c[state] == 2 * a[state] - b[state]);
+	};
+
+	expr(c) = -expr(c) + a * expr(b) / 2;
+	expr(c) += 1;
+	expr(c) *= expr(a);
+
+	traverser(c) | [&](auto state) {
+		REQUIRE(c[state] == (-(2 * a[state] - b[state]) + a[state] * b[state] / 2 + 1) * a[state]);
+	};
+
+	expr(c) = expr(a);
+
+	traverser(c) | [&](auto state) {
+		REQUIRE(c[state] == a[state]);
+	};
+}
+
+TEST_CASE("Expressions broadcast over missing dimensions", "[expr]") {
+	auto m_data = make_bag(scalar<int>() ^ vector<'j'>(4) ^ vector<'i'>(3));
+	auto u_data = make_bag(scalar<int>() ^ vector<'i'>(3));
+	auto v_data = make_bag(scalar<int>() ^ vector<'j'>(4));
+	auto m = m_data.get_ref();
+	auto u = u_data.get_ref();
+	auto v = v_data.get_ref();
+
+	traverser(u) | [&](auto state) { u[state] = (int)get_index<'i'>(state) + 1; };
+	traverser(v) | [&](auto state) { v[state] = (int)get_index<'j'>(state) * 2; };
+
+	// an outer product
+	expr(m) = expr(u) * v;
+
+	traverser(m) | [&](auto state) {
+		auto [i, j] = get_indices<'i', 'j'>(state);
+		REQUIRE(m[state] == (int)((i + 1) * j * 2));
+	};
+
+	// a matrix-vector product: the target lacks 'j', so it accumulates over it
+	expr(u) = 0;
+	expr(u) ^ hoist<'i'>() += expr(m) * v;
+
+	for (std::size_t i = 0; i < 3; i++)
+		REQUIRE(u[idx<'i'>(i)] == (int)((i + 1) * (0 + 4 + 16 + 36)));
+}
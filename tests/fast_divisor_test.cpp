@@ -0,0 +1,85 @@
+#include <noarr_test/macros.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include <noarr/structures.hpp>
+#include <noarr/structures/base/fast_divisor.hpp>
+#include <noarr/structures/extra/shortcuts.hpp>
+#include <noarr/structures/extra/traverser.hpp>
+#include <noarr/structures/structs/blocks.hpp>
+
+using namespace noarr;
+
+static_assert(fast_divisor(7).divide(100) == 14);
+static_assert(fast_divisor(7).modulo(100) == 2);
+static_assert(fast_divisor(64).divide(1000) == 15);
+static_assert(fast_divisor(1).divide(12345) == 12345);
+
+TEST_CASE("Fast division", "[fast_divisor]") {
+	constexpr std::size_t max = std::numeric_limits<std::size_t>::max();
+	const std::size_t numerators[] = {0, 1, 2, 3, 7, 100, 641, 1000, 65535, 65536, 1'000'000'007, max / 3, max / 2, max - 1, max};
+
+	auto check = [&](std::size_t d) {
+		const fast_divisor divisor(d);
+		for (std::size_t n : numerators) {
+			REQUIRE(divisor.divide(n) == n / d);
+			REQUIRE(divisor.modulo(n) == n % d);
+		}
+		for (std::size_t n = 0; n < 3 * d && n < 3000; n++)
+			REQUIRE(divisor.divide(n) == n / d);
+	};
+
+	for (std::size_t d = 1; d < 2000; d++)
+		check(d);
+	for (std::size_t d : {std::size_t(641), std::size_t(1) << 32, (std::size_t(1) << 32) + 1, std::size_t(6700417), max / 2, max / 2 + 1, max - 1, max})
+		check(d);
+}
+
+TEST_CASE("Division and remainder", "[fast_divisor]") {
+	auto [q, r] = div_mod(std::size_t(100), std::size_t(7));
+	REQUIRE(q == 14);
+	REQUIRE(r == 2);
+
+	const fast_divisor seven(7);
+	auto [q_kept, r_kept] = div_mod(std::size_t(100), seven);
+	REQUIRE(q_kept == 14);
+	REQUIRE(r_kept == 2);
+
+	// a zero divisor can be kept (e.g. for an empty dimension), it is just never divided by
+	REQUIRE(fast_divisor(0).divisor == 0);
+
+	auto [q_static, r_static] = div_mod(lit<100>, lit<7>);
+	STATIC_REQUIRE(decltype(q_static)::value == 14);
+	STATIC_REQUIRE(decltype(r_static)::value == 2);
+}
+
+TEST_CASE("Merge dynamic blocks", "[fast_divisor]") {
+	for (std::size_t minor : {0, 1, 3, 8, 13}) {
+		auto s = scalar<int>() ^ vector<'x'>(5) ^ vector<'y'>(minor) ^ merge_blocks<'x', 'y', 'w'>();
+		auto t = scalar<int>() ^ vector<'x'>(5) ^ vector<'y'>(minor);
+
+		// the divisor is precomputed when the structure is constructed
+		REQUIRE(s.minor_divisor().divisor == minor);
+
+		REQUIRE((s | get_length<'w'>()) == 5 * minor);
+		traverser(s) | [&](auto state) {
+			const std::size_t w = get_index<'w'>(state);
+			REQUIRE((s | offset(state)) == (t | offset<'x', 'y'>(w / minor, w % minor)));
+		};
+	}
+}
+
+TEST_CASE("Merge static blocks", "[fast_divisor]") {
+	auto s = scalar<int>() ^ vector<'x'>(5) ^ vector<'y'>(lit<6>) ^ merge_blocks<'x', 'y', 'w'>();
+	auto t = scalar<int>() ^ vector<'x'>(5) ^ vector<'y'>(lit<6>);
+
+	// a static minor length needs no divisor
+	STATIC_REQUIRE(std::is_empty_v<decltype(s.minor_divisor())>);
+
+	traverser(s) | [&](auto state) {
+		const std::size_t w = get_index<'w'>(state);
+		REQUIRE((s | offset(state)) == (t | offset<'x', 'y'>(w / 6, w % 6)));
+	};
+}
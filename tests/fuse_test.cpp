@@ -0,0 +1,75 @@
+#include <noarr_test/macros.hpp>
+
+#include <vector>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("Fused column passes", "[fuse]") {
+	auto data_data = make_bag(scalar<int>() ^ vector<'j'>(5) ^ vector<'k'>(4));
+	auto sum_data = make_bag(scalar<int>() ^ vector<'j'>(5));
+	auto max_data = make_bag(scalar<int>() ^ vector<'j'>(5));
+	auto data = data_data.get_ref();
+	auto sum = sum_data.get_ref();
+	auto max = max_data.get_ref();
+
+	traverser(data) | [&](auto state) {
+		auto [j, k] = get_indices<'j', 'k'>(state);
+		data[state] = (int)(j * 3 + k * k);
+	};
+
+	std::vector<int> trace;
+
+	traverser(data, sum, max) | fuse<'j'>(
+		[&](auto inner) {
+			sum[inner] = 0;
+			inner | [&](auto state) { sum[state] += data[state]; };
+			trace.push_back(0);
+		},
+		for_each<'k'>([&](auto state) {
+			// the sum of the column is already complete
+			data[state] -= sum[state];
+			trace.push_back(1);
+		}),
+		[&](auto inner) {
+			max[inner] = data[inner.state() & idx<'k'>(0)];
+			inner | [&](auto state) { max[state] = data[state] > max[state] ? data[state] : max[state]; };
+			trace.push_back(2);
+		});
+
+	for (std::size_t j = 0; j < 5; j++) {
+		REQUIRE(sum[idx<'j'>(j)] == (int)(4 * j * 3 + 0 + 1 + 4 + 9));
+		REQUIRE(max[idx<'j'>(j)] == (int)(j * 3 + 9) - sum[idx<'j'>(j)]);
+	}
+
+	// the bodies are interleaved per column
+	REQUIRE(trace.size() == 5 * 6);
+	for (std::size_t j = 0; j < 5; j++) {
+		REQUIRE(trace[j * 6] == 0);
+		for (std::size_t k = 0; k < 4; k++)
+			REQUIRE(trace[j * 6 + 1 + k] == 1);
+		REQUIRE(trace[j * 6 + 5] == 2);
+	}
+}
+
+TEST_CASE("Fused elementwise passes", "[fuse]") {
+	auto a_data = make_bag(scalar<int>() ^ vector<'i'>(6) ^ vector<'j'>(3));
+	auto a = a_data.get_ref();
+
+	std::vector<int> trace;
+
+	traverser(a) | fuse(
+		[&](auto state) { a[state] = (int)get_index<'i'>(state); trace.push_back(0); },
+		[&](auto state) { a[state] *= 2; trace.push_back(1); });
+
+	traverser(a) | [&](auto state) {
+		REQUIRE(a[state] == 2 * (int)get_index<'i'>(state));
+	};
+
+	REQUIRE(trace.size() == 2 * 18);
+	for (std::size_t n = 0; n < 18; n++) {
+		REQUIRE(trace[2 * n] == 0);
+		REQUIRE(trace[2 * n + 1] == 1);
+	}
+}
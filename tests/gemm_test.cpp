@@ -0,0 +1,131 @@
+#include <noarr_test/macros.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include <noarr/traversers.hpp>
+
+#ifdef _OPENMP
+#include <noarr/structures/interop/omp.hpp>
+#endif
+
+#ifdef NOARR_TEST_TBB
+#include <noarr/structures/interop/tbb.hpp>
+#endif
+
+using namespace noarr;
+
+namespace {
+
+template<class T>
+T value(std::size_t a, std::size_t b, std::size_t n) {
+	return T((a * (b + 3) + 1) % n) / T(n);
+}
+
+// `C = alpha * A * B + beta * C` computed by the plain traversal
+void naive_gemm(auto C, auto A, auto B, auto alpha, auto beta) {
+	traverser(C) | [=](auto state) { C[state] *= beta; };
+	traverser(C, A, B) | [=](auto state) { C[state] += alpha * A[state] * B[state]; };
+}
+
+} // namespace
+
+TEST_CASE("Matrix product", "[gemm]") {
+	for (auto [m, n, k] : {std::array<std::size_t, 3>{13, 37, 29}, {700, 50, 600}, {1, 1, 1}, {6, 32, 1}}) {
+		auto c_data = make_bag(scalar<double>() ^ vectors<'j', 'i'>(n, m));
+		auto c_ref = make_bag(scalar<double>() ^ vectors<'j', 'i'>(n, m));
+		auto a = make_bag(scalar<double>() ^ vectors<'k', 'i'>(k, m));
+		// B is stored transposed
+		auto b = make_bag(scalar<double>() ^ vectors<'k', 'j'>(k, n));
+
+		traverser(c_data) | [&](auto state) { c_data[state] = c_ref[state] = value<double>(get_index<'i'>(state), get_index<'j'>(state), 7); };
+		traverser(a) | [&](auto state) { a[state] = value<double>(get_index<'i'>(state), get_index<'k'>(state), 11); };
+		traverser(b) | [&](auto state) { b[state] = value<double>(get_index<'k'>(state), get_index<'j'>(state), 13); };
+
+		gemm(c_data.get_ref(), a.get_ref(), b.get_ref(), 1.5, 1.2);
+		naive_gemm(c_ref.get_ref(), a.get_ref(), b.get_ref(), 1.5, 1.2);
+
+		traverser(c_data) | [&](auto state) { REQUIRE(std::abs(c_data[state] - c_ref[state]) <= 1e-12 * double(k)); };
+	}
+}
+
+TEST_CASE("Matrix product of renamed views", "[gemm]") {
+	constexpr std::size_t n = 19;
+	auto x = make_bag(scalar<float>() ^ vectors<'j', 'i'>(n, n));
+	auto y = make_bag(scalar<float>() ^ vectors<'j', 'i'>(n, n));
+	auto z = make_bag(scalar<float>() ^ vectors<'j', 'i'>(n, n));
+	auto z_ref = make_bag(scalar<float>() ^ vectors<'j', 'i'>(n, n));
+
+	traverser(x) | [&](auto state) {
+		auto [i, j] = get_indices<'i', 'j'>(state);
+		x[state] = value<float>(i, j, 5);
+		y[state] = value<float>(j, i, 9);
+	};
+
+	// z = x^T * y: x^T has the rows in 'j' (as 'i') and the inner dimension in 'i' (as 'k'), y has the inner dimension in 'i' (as 'k')
+	const auto x_t = x.get_ref() ^ rename<'i', 'k', 'j', 'i'>();
+	const auto y_k = y.get_ref() ^ rename<'i', 'k'>();
+	gemm(z.get_ref(), x_t, y_k, 1.0f, 0.0f);
+
+	traverser(z_ref) | [&](auto state) { z_ref[state] = 0; };
+	naive_gemm(z_ref.get_ref(), x_t, y_k, 1.0f, 1.0f);
+
+	traverser(z) | [&](auto state) { REQUIRE(std::abs(z[state] - z_ref[state]) <= 1e-5f); };
+
+	// the dimensions can also be given explicitly
+	gemm<'i', 'j', 'k'>(z.get_ref(), x_t, y_k, -1.0f, 1.0f);
+	traverser(z) | [&](auto state) { REQUIRE(std::abs(z[state]) <= 1e-5f); };
+}
+
+TEST_CASE("Matrix product special cases", "[gemm]") {
+	auto c = make_bag(scalar<double>() ^ vectors<'j', 'i'>(8, 7));
+	auto a = make_bag(scalar<double>() ^ vectors<'k', 'i'>(3, 7));
+	auto b = make_bag(scalar<double>() ^ vectors<'j', 'k'>(8, 3));
+	traverser(a) | [&](auto state) { a[state] = 1; };
+	traverser(b) | [&](auto state) { b[state] = 2; };
+
+	// C is not read with a zero `beta`
+	traverser(c) | [&](auto state) { c[state] = std::numeric_limits<double>::quiet_NaN(); };
+	gemm(c.get_ref(), a.get_ref(), b.get_ref(), 0.5, 0.0);
+	traverser(c) | [&](auto state) { REQUIRE(c[state] == 3); };
+
+	// an empty product only scales C
+	auto a_empty = make_bag(scalar<double>() ^ vectors<'k', 'i'>(0, 7));
+	auto b_empty = make_bag(scalar<double>() ^ vectors<'j', 'k'>(8, 0));
+	gemm(c.get_ref(), a_empty.get_ref(), b_empty.get_ref(), 0.5, 2.0);
+	traverser(c) | [&](auto state) { REQUIRE(c[state] == 6); };
+}
+
+TEST_CASE("Parallel matrix product", "[gemm]") {
+	// more rows than a single block of rows, and fewer rows than a block (split among the threads by the panels of B)
+	for (auto [m, n, k] : {std::array<std::size_t, 3>{700, 50, 300}, {40, 100, 700}, {5, 7, 3}}) {
+		auto c_ref = make_bag(scalar<double>() ^ vectors<'j', 'i'>(n, m));
+		auto a = make_bag(scalar<double>() ^ vectors<'k', 'i'>(k, m));
+		auto b = make_bag(scalar<double>() ^ vectors<'j', 'k'>(n, k));
+
+		traverser(c_ref) | [&](auto state) { c_ref[state] = value<double>(get_index<'i'>(state), get_index<'j'>(state), 7); };
+		traverser(a) | [&](auto state) { a[state] = value<double>(get_index<'i'>(state), get_index<'k'>(state), 11); };
+		traverser(b) | [&](auto state) { b[state] = value<double>(get_index<'k'>(state), get_index<'j'>(state), 13); };
+
+		[[maybe_unused]] const auto check = [&](auto gemm_fn) {
+			auto c = make_bag(scalar<double>() ^ vectors<'j', 'i'>(n, m));
+			traverser(c) | [&](auto state) { c[state] = value<double>(get_index<'i'>(state), get_index<'j'>(state), 7); };
+			gemm_fn(c.get_ref());
+			traverser(c) | [&](auto state) { REQUIRE(std::abs(c[state] - c_ref[state]) <= 1e-12 * double(k)); };
+		};
+
+		naive_gemm(c_ref.get_ref(), a.get_ref(), b.get_ref(), 1.5, 1.2);
+
+#ifdef _OPENMP
+		check([&](auto c) { omp_gemm(c, a.get_ref(), b.get_ref(), 1.5, 1.2); });
+		check([&](auto c) { omp_gemm<'i', 'j', 'k'>(c, a.get_ref(), b.get_ref(), 1.5, 1.2); });
+#endif
+
+#ifdef NOARR_TEST_TBB
+		check([&](auto c) { tbb_gemm(c, a.get_ref(), b.get_ref(), 1.5, 1.2); });
+		check([&](auto c) { tbb_gemm<'i', 'j', 'k'>(c, a.get_ref(), b.get_ref(), 1.5, 1.2); });
+#endif
+	}
+}
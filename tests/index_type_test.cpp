@@ -0,0 +1,60 @@
+#include <noarr_test/macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("32-bit lengths give 32-bit indices", "[index_type]") {
+	auto data = make_bag(scalar<int>() ^ vector<'j'>(std::uint32_t(5)) ^ vector<'i'>(std::uint32_t(4)));
+	auto m = data.get_ref();
+
+	STATIC_REQUIRE(std::is_same_v<decltype(m.structure() | get_length<'i'>()), std::uint32_t>);
+
+	std::size_t count = 0;
+	traverser(m) | [&](auto state) {
+		STATIC_REQUIRE(std::is_same_v<state_get_t<decltype(state), index_in<'i'>>, std::uint32_t>);
+		STATIC_REQUIRE(std::is_same_v<state_get_t<decltype(state), index_in<'j'>>, std::uint32_t>);
+		m[state] = int(count++);
+	};
+	REQUIRE(count == 20);
+
+	// the offsets are the same as with 64-bit indices
+	auto wide = scalar<int>() ^ vector<'j'>(5) ^ vector<'i'>(4);
+	traverser(m) | [&](auto state) {
+		REQUIRE(m[state] == int((wide | offset(state)) / sizeof(int)));
+		REQUIRE(&m[state] == &m[idx<'i', 'j'>(std::size_t(get_index<'i'>(state)), std::size_t(get_index<'j'>(state)))]);
+	};
+}
+
+TEST_CASE("32-bit indices set by set_length", "[index_type]") {
+	auto s = scalar<float>() ^ vectors<'j', 'i'>() ^ set_length<'i', 'j'>(std::uint32_t(3), 7);
+
+	traverser(s) | [&](auto state) {
+		STATIC_REQUIRE(std::is_same_v<state_get_t<decltype(state), index_in<'i'>>, std::uint32_t>);
+		STATIC_REQUIRE(std::is_same_v<state_get_t<decltype(state), index_in<'j'>>, std::size_t>);
+	};
+}
+
+TEST_CASE("Neighbors of 32-bit indices", "[index_type]") {
+	auto state = idx<'i', 'j'>(std::uint32_t(5), std::uint32_t(2));
+	STATIC_REQUIRE(std::is_same_v<state_get_t<decltype(state), index_in<'i'>>, std::uint32_t>);
+
+	auto moved = neighbor<'i', 'j'>(state, -1, 1);
+	STATIC_REQUIRE(std::is_same_v<state_get_t<decltype(moved), index_in<'i'>>, std::uint32_t>);
+	REQUIRE(get_index<'i'>(moved) == 4);
+	REQUIRE(get_index<'j'>(moved) == 3);
+}
+
+TEST_CASE("Merging 32-bit lengths", "[index_type]") {
+	// 70000 * 70000 does not fit in 32 bits
+	auto s = scalar<char>() ^ vector<'j'>(std::uint32_t(70000)) ^ vector<'i'>(std::uint32_t(70000)) ^ merge_blocks<'i', 'j', 'm'>();
+
+	STATIC_REQUIRE(std::is_same_v<decltype(s | get_length<'m'>()), std::size_t>);
+	REQUIRE((s | get_length<'m'>()) == std::size_t(70000) * 70000);
+	REQUIRE((s | offset<'m'>(std::size_t(70000) * 70000 - 1)) == std::size_t(70000) * 70000 - 1);
+	REQUIRE((s | offset<'m'>(std::size_t(70000) * 12345 + 678)) == std::size_t(70000) * 12345 + 678);
+}
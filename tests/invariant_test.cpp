@@ -0,0 +1,64 @@
+#include <noarr_test/macros.hpp>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("Invariant accesses", "[invariant]") {
+	auto c_data = make_bag(scalar<int>() ^ vector<'j'>(4) ^ vector<'i'>(3));
+	auto a_data = make_bag(scalar<int>() ^ vector<'k'>(5) ^ vector<'i'>(3));
+	auto b_data = make_bag(scalar<int>() ^ vector<'j'>(4) ^ vector<'k'>(5));
+	auto c = c_data.get_ref();
+	auto a = a_data.get_ref();
+	auto b = b_data.get_ref();
+
+	traverser(a) | [&](auto state) { a[state] = int(get_index<'i'>(state) + get_index<'k'>(state)); };
+	traverser(b) | [&](auto state) { b[state] = int(get_index<'k'>(state) * get_index<'j'>(state)); };
+	traverser(c) | [&](auto state) { c[state] = 0; };
+
+	auto t = traverser(c, a, b) ^ hoist<'k'>() ^ hoist<'i'>();
+
+	STATIC_REQUIRE(!is_invariant_in<decltype(a), decltype(t)>);
+
+	t | for_dims<'i', 'k'>([&](auto inner) {
+		STATIC_REQUIRE(is_invariant_in<decltype(a), decltype(inner)>);
+		STATIC_REQUIRE(!is_invariant_in<decltype(c), decltype(inner)>);
+
+		const auto a_ik = invariant(a, inner);
+		REQUIRE(a_ik == a[inner]);
+
+		inner | [&](auto state) { c[state] += a_ik * b[state]; };
+	});
+
+	traverser(c) | [&](auto state) {
+		int expected = 0;
+		for (int k = 0; k < 5; k++)
+			expected += int(get_index<'i'>(state) + k) * int(k * get_index<'j'>(state));
+		REQUIRE(c[state] == expected);
+	};
+}
+
+TEST_CASE("Scalar replacement of accumulators", "[invariant]") {
+	auto c_data = make_bag(scalar<int>() ^ vector<'j'>(4) ^ vector<'i'>(3));
+	auto a_data = make_bag(scalar<int>() ^ vector<'k'>(5) ^ vector<'i'>(3));
+	auto b_data = make_bag(scalar<int>() ^ vector<'j'>(4) ^ vector<'k'>(5));
+	auto c = c_data.get_ref();
+	auto a = a_data.get_ref();
+	auto b = b_data.get_ref();
+
+	traverser(a) | [&](auto state) { a[state] = int(get_index<'i'>(state) + get_index<'k'>(state)); };
+	traverser(b) | [&](auto state) { b[state] = int(get_index<'k'>(state) * get_index<'j'>(state)); };
+	traverser(c) | [&](auto state) { c[state] = 1; };
+
+	traverser(c, a, b) | for_dims<'i', 'j'>([&](auto inner) {
+		STATIC_REQUIRE(is_invariant_in<decltype(c), decltype(inner)>);
+		inner | accumulate_into(c, [&](int &acc, auto state) { acc += a[state] * b[state]; });
+	});
+
+	traverser(c) | [&](auto state) {
+		int expected = 1;
+		for (int k = 0; k < 5; k++)
+			expected += int(get_index<'i'>(state) + k) * int(k * get_index<'j'>(state));
+		REQUIRE(c[state] == expected);
+	};
+}
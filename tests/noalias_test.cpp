@@ -0,0 +1,45 @@
+#include <noarr_test/macros.hpp>
+
+#include <type_traits>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("Noalias bags", "[noalias]") {
+	auto structure = scalar<float>() ^ vector<'i'>(100);
+	auto c_data = make_bag(structure);
+	auto a_data = make_bag(structure);
+	auto b_data = make_bag(structure);
+
+	auto [c, a, b] = noalias(c_data, a_data, b_data);
+	STATIC_REQUIRE(std::is_same_v<decltype(c), restrict_bag<decltype(structure)>>);
+	REQUIRE(c.data() == c_data.data());
+
+	traverser(a, b) | [=](auto state) {
+		a[state] = float(get_index<'i'>(state));
+		b[state] = 2;
+	};
+	traverser(c) | [=](auto state) { c[state] = 1; };
+
+	traverser(c, a, b) | [=](auto state) { c[state] += a[state] * b[state]; };
+
+	traverser(c_data) | [&](auto state) { REQUIRE(c_data[state] == 1 + 2 * float(get_index<'i'>(state))); };
+
+	// a read-only bag stays read-only
+	auto r = noalias(make_bag(structure, static_cast<const void *>(a_data.data())));
+	STATIC_REQUIRE(std::is_same_v<decltype(r), const_restrict_bag<decltype(structure)>>);
+	REQUIRE(r[idx<'i'>(7)] == 7);
+}
+
+TEST_CASE("Overlap of bags", "[noalias]") {
+	auto data = make_bag(scalar<float>() ^ vector<'i'>(100));
+	auto whole = data.get_ref();
+	auto first = make_bag(scalar<float>() ^ vector<'i'>(50), data.data());
+	auto second = make_bag(scalar<float>() ^ vector<'i'>(50), static_cast<char *>(data.data()) + 50 * sizeof(float));
+
+	REQUIRE(bags_disjoint(first, second));
+	REQUIRE(!bags_disjoint(first, whole));
+	REQUIRE(!bags_disjoint(first, second, whole));
+	REQUIRE(bags_disjoint(first));
+}
@@ -0,0 +1,131 @@
+#include <noarr_test/macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("Packed tiles are copied in and out", "[pack_tile]") {
+	auto a = make_bag(scalar<int>() ^ vector<'j'>(23) ^ vector<'i'>(19));
+	traverser(a) | [&](auto state) {
+		auto [i, j] = get_indices<'i', 'j'>(state);
+		a[state] = int(i * 100 + j);
+	};
+
+	int tiles = 0;
+	traverser(a) ^ into_blocks_clamped<'i', 'I'>(lit<8>) ^ into_blocks_clamped<'j', 'J'>(lit<5>) | for_dims<'I', 'J'>([&](auto inner) {
+		inner | pack_tile<'i', 'j'>(a, [&](auto tile, auto inner) {
+			const std::size_t i0 = tile.template origin<'i'>();
+			const std::size_t j0 = tile.template origin<'j'>();
+			REQUIRE(i0 % 8 == 0);
+			REQUIRE(j0 % 5 == 0);
+			// the tile is transposed ('i' is contiguous) and clamped at the border
+			REQUIRE((tile.buffer() | get_length<'i'>()) == std::min<std::size_t>(8, 19 - i0));
+			REQUIRE((tile.buffer() | get_length<'j'>()) == std::min<std::size_t>(5, 23 - j0));
+			REQUIRE((tile.buffer() | offset<'i', 'j'>(1, 0)) == sizeof(int));
+			REQUIRE(reinterpret_cast<std::uintptr_t>(tile.data()) % 64 == 0);
+
+			inner | [&](auto state) {
+				REQUIRE(tile[state] == a[state]);
+				tile[state] *= -1;
+			};
+			tiles++;
+		});
+	});
+	REQUIRE(tiles == 3 * 5);
+
+	traverser(a) | [&](auto state) {
+		auto [i, j] = get_indices<'i', 'j'>(state);
+		REQUIRE(a[state] == -int(i * 100 + j));
+	};
+}
+
+TEST_CASE("Read-only transposed packed tiles", "[pack_tile]") {
+	auto c = make_bag(scalar<long>() ^ vector<'j'>(13) ^ vector<'i'>(11));
+	auto a = make_bag(scalar<long>() ^ vector<'k'>(9) ^ vector<'i'>(11));
+	auto b = make_bag(scalar<long>() ^ vector<'j'>(13) ^ vector<'k'>(9));
+	auto c_ref = make_bag(scalar<long>() ^ vector<'j'>(13) ^ vector<'i'>(11));
+
+	traverser(a) | [&](auto state) { a[state] = long(get_index<'i'>(state) * 3 + get_index<'k'>(state)); };
+	traverser(b) | [&](auto state) { b[state] = long(get_index<'k'>(state) * 7) - long(get_index<'j'>(state)); };
+	traverser(c) | [&](auto state) { c[state] = 0; c_ref[state] = 0; };
+	traverser(c_ref, a, b) | [&](auto state) { c_ref[state] += a[state] * b[state]; };
+
+	traverser(c, a, b) ^ into_blocks_clamped<'j', 'J'>(lit<4>) | for_dims<'J'>([&](auto inner) {
+		// the innermost loop is 'k', so 'k' is the contiguous dimension of the packed tile
+		inner ^ hoist<'i', 'j'>() | pack_tile_in<'k', 'j'>(b, [&](auto tile, auto inner) {
+			REQUIRE((tile.buffer() | offset<'k', 'j'>(1, 0)) == sizeof(long));
+			REQUIRE((tile.buffer() | get_length<'k'>()) == 9);
+			inner | [&](auto state) {
+				STATIC_REQUIRE(std::is_const_v<std::remove_reference_t<decltype(tile[state])>>);
+				c[state] += a[state] * tile[state];
+			};
+		});
+	});
+
+	traverser(c) | [&](auto state) { REQUIRE(c[state] == c_ref[state]); };
+}
+
+TEST_CASE("Nested packed tiles", "[pack_tile]") {
+	auto a = make_bag(scalar<int>() ^ vector<'i'>(10));
+	auto b = make_bag(scalar<int>() ^ vector<'j'>(6));
+	traverser(a) | [&](auto state) { a[state] = int(get_index<'i'>(state)); };
+	traverser(b) | [&](auto state) { b[state] = 100 * int(get_index<'j'>(state)); };
+
+	traverser(a, b) | pack_tile<'i'>(a, [&](auto a_tile, auto t) {
+		t | pack_tile<'j'>(b, [&](auto b_tile, auto t) {
+			REQUIRE(a_tile.data() != b_tile.data());
+			t | for_dims<'i'>([&](auto inner) {
+				inner | [&](auto state) { b_tile[state] += a_tile[state]; };
+			});
+		});
+	});
+
+	traverser(b) | [&](auto state) { REQUIRE(b[state] == 100 * int(get_index<'j'>(state)) + 45); };
+}
+
+TEST_CASE("Packed tile buffers are released by exceptions", "[pack_tile]") {
+	auto a = make_bag(scalar<int>() ^ vector<'i'>(10));
+
+	const void *first = nullptr;
+	traverser(a) | pack_tile_in<'i'>(a, [&](auto tile, auto) { first = tile.data(); });
+
+	bool thrown = false;
+	try {
+		traverser(a) | pack_tile_in<'i'>(a, [&](auto, auto) { throw 1; });
+	} catch (int) {
+		thrown = true;
+	}
+	REQUIRE(thrown);
+
+	// the buffer of the outermost tile is reused (a leaked buffer would make the next tile take a new one)
+	const void *after = nullptr;
+	traverser(a) | pack_tile_in<'i'>(a, [&](auto tile, auto) { after = tile.data(); });
+	REQUIRE(after == first);
+}
+
+TEST_CASE("Packed tile buffers survive a failed allocation", "[pack_tile]") {
+	auto a = make_bag(scalar<int>() ^ vector<'i'>(10));
+
+	const void *first = nullptr;
+	traverser(a) | pack_tile_in<'i'>(a, [&](auto tile, auto) { first = tile.data(); });
+
+	bool thrown = false;
+	try {
+		const helpers::pack_tile_buffer huge(std::numeric_limits<std::size_t>::max() / 2);
+	} catch (const std::bad_alloc &) {
+		thrown = true;
+	}
+	REQUIRE(thrown);
+
+	// neither the depth nor the (smaller) buffer of the outermost tile is lost
+	const void *after = nullptr;
+	traverser(a) | pack_tile_in<'i'>(a, [&](auto tile, auto) { after = tile.data(); });
+	REQUIRE(after != nullptr);
+	REQUIRE(after == first);
+}
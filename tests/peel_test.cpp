@@ -0,0 +1,66 @@
+#include <noarr_test/macros.hpp>
+
+#include <vector>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("Peel for_each", "[peel]") {
+	auto a = scalar<int>() ^ vector<'j'>(4) ^ vector<'i'>(10);
+
+	std::vector<std::pair<std::size_t, peel_region>> visited;
+
+	traverser(a) | peel<'i'>(2, 3).for_each([&](auto state, auto region) {
+		STATIC_REQUIRE(std::is_same_v<decltype(region), peel_region_t<decltype(region)::value>>);
+		if (get_index<'j'>(state) == 0)
+			visited.emplace_back(get_index<'i'>(state), region);
+	});
+
+	REQUIRE(visited.size() == 10);
+	for (std::size_t i = 0; i < 10; i++) {
+		REQUIRE(visited[i].first == i);
+		REQUIRE(visited[i].second == (i < 2 ? peel_region::front : i < 7 ? peel_region::body : peel_region::back));
+	}
+}
+
+TEST_CASE("Peel for_dims", "[peel]") {
+	auto a = scalar<int>() ^ vector<'j'>(4) ^ vector<'i'>(10);
+
+	std::size_t front = 0, body = 0, back = 0;
+	std::size_t next = 3;
+
+	traverser(a) ^ span<'j'>(3, 4) ^ hoist<'j'>() | peel<'j'>(1, 0).for_dims<'j'>([&](auto inner, auto region) {
+		REQUIRE(get_index<'j'>(inner) == next++);
+
+		inner | [&](auto) {
+			if constexpr (region == peel_region::front)
+				front++;
+			else if constexpr (region == peel_region::body)
+				body++;
+			else
+				back++;
+		};
+	});
+
+	REQUIRE(next == 4);
+	REQUIRE(front == 10);
+	REQUIRE(body == 0);
+	REQUIRE(back == 0);
+}
+
+TEST_CASE("Peel short dimension", "[peel]") {
+	auto a = scalar<int>() ^ vector<'i'>(3);
+
+	const auto p = peel<'i'>(2, lit<2>);
+
+	REQUIRE((p.front(traverser(a)).top_struct() | get_length<'i'>()) == 2);
+	REQUIRE((p.body(traverser(a)).top_struct() | get_length<'i'>()) == 0);
+	REQUIRE((p.back(traverser(a)).top_struct() | get_length<'i'>()) == 1);
+
+	std::size_t count = 0;
+	traverser(a) | p.for_each([&](auto state, auto) {
+		REQUIRE(get_index<'i'>(state) == count++);
+	});
+	REQUIRE(count == 3);
+}
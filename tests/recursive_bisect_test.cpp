@@ -0,0 +1,86 @@
+#include <noarr_test/macros.hpp>
+
+#include <vector>
+
+#include <noarr/traversers.hpp>
+
+#ifdef NOARR_TEST_TBB
+#include <noarr/structures/interop/tbb.hpp>
+#endif
+
+using namespace noarr;
+
+TEST_CASE("Recursive bisection coverage", "[recursive_bisect]") {
+	auto a = scalar<int>() ^ vector<'k'>(13) ^ vector<'j'>(7) ^ vector<'i'>(21);
+
+	std::vector<int> visited(21 * 7 * 13, 0);
+	std::size_t tiles = 0;
+
+	traverser(a) | recursive_bisect<'i', 'j', 'k'>(4).for_tiles([&](auto tile) {
+		tiles++;
+		REQUIRE((tile.top_struct() | get_length<'i'>()) <= 4);
+		REQUIRE((tile.top_struct() | get_length<'j'>()) <= 4);
+		REQUIRE((tile.top_struct() | get_length<'k'>()) <= 4);
+
+		tile | [&](auto state) {
+			auto [i, j, k] = get_indices<'i', 'j', 'k'>(state);
+			visited[(i * 7 + j) * 13 + k]++;
+		};
+	});
+
+	// 21 -> 10 + 11 -> 5 + 5 + 5 + 6 -> 8 tiles; 13 -> 6 + 7 -> 4 tiles; 7 -> 3 + 4 -> 2 tiles
+	REQUIRE(tiles == 8 * 4 * 2);
+	for (auto v : visited)
+		REQUIRE(v == 1);
+}
+
+TEST_CASE("Recursive bisection preserves the order along each dimension", "[recursive_bisect]") {
+	auto a = scalar<int>() ^ vector<'k'>(9) ^ vector<'j'>(10) ^ vector<'i'>(11);
+
+	// the last k visited for each (i, j)
+	std::vector<int> last_k(11 * 10, -1);
+	std::size_t count = 0;
+
+	traverser(a) | recursive_bisect<'i', 'j', 'k'>(2).for_each([&](auto state) {
+		auto [i, j, k] = get_indices<'i', 'j', 'k'>(state);
+		REQUIRE(last_k[i * 10 + j] == (int)k - 1);
+		last_k[i * 10 + j] = (int)k;
+		count++;
+	});
+
+	REQUIRE(count == 11 * 10 * 9);
+
+	// a leaf as large as the space yields the original order
+	std::size_t expected = 0;
+	traverser(a) | recursive_bisect<'i', 'j', 'k'>(11).for_each([&](auto state) {
+		REQUIRE((a | offset(state)) == expected * sizeof(int));
+		expected++;
+	});
+}
+
+#ifdef NOARR_TEST_TBB
+TEST_CASE("Parallel recursive bisection with a sequential dimension", "[recursive_bisect]") {
+	auto a = scalar<int>() ^ vector<'k'>(23) ^ vector<'j'>(17) ^ vector<'i'>(19);
+
+	// the visits of each element and, for each (i, j), the last k visited and whether the k were visited in order
+	// (the checks are done after the traversal, the bodies only write to their own elements)
+	std::vector<int> visited(19 * 17 * 23, 0);
+	std::vector<int> last_k(19 * 17, -1);
+	std::vector<char> in_order(19 * 17, 1);
+
+	tbb_for_each_bisect<'k'>(traverser(a), recursive_bisect<'i', 'j', 'k'>(3), [&](auto state) {
+		auto [i, j, k] = get_indices<'i', 'j', 'k'>(state);
+		visited[(i * 17 + j) * 23 + k]++;
+		if (last_k[i * 17 + j] != (int)k - 1)
+			in_order[i * 17 + j] = 0;
+		last_k[i * 17 + j] = (int)k;
+	});
+
+	for (auto v : visited)
+		REQUIRE(v == 1);
+	for (auto ordered : in_order)
+		REQUIRE(ordered);
+	for (auto k : last_k)
+		REQUIRE(k == 22);
+}
+#endif
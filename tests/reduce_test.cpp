@@ -0,0 +1,61 @@
+#include <noarr_test/macros.hpp>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("Multi-accumulator sum", "[reduce]") {
+	auto a_data = make_bag(scalar<int>() ^ vector<'k'>(23) ^ vector<'j'>(3));
+	auto a = a_data.get_ref();
+
+	traverser(a) | [&](auto state) {
+		auto [j, k] = get_indices<'j', 'k'>(state);
+		a[state] = (int)(j * 100 + k);
+	};
+
+	// a reduction of each row, with the default number of accumulators and with more accumulators than indices
+	traverser(a) | for_dims<'j'>([&](auto inner) {
+		auto j = get_index<'j'>(inner);
+		REQUIRE((inner | reduce<'k'>(0, [&](auto state) { return a[state]; })) == (int)(23 * j * 100 + 22 * 23 / 2));
+		REQUIRE((inner | reduce<'k', 32>(5, [&](auto state) { return a[state]; })) == (int)(5 + 23 * j * 100 + 22 * 23 / 2));
+	});
+
+	// a reduction over all the dimensions, distributed by the rows
+	REQUIRE((traverser(a) | reduce<'j', 2>(0, [&](auto state) { return a[state]; })) == (int)(23 * 300 + 3 * 22 * 23 / 2));
+	REQUIRE((traverser(a) | reduce<'k', 3>(0, [&](auto state) { return a[state]; })) == (int)(23 * 300 + 3 * 22 * 23 / 2));
+}
+
+TEST_CASE("Multi-accumulator reduction with an operator", "[reduce]") {
+	auto a_data = make_bag(scalar<int>() ^ vector<'i'>(17));
+	auto a = a_data.get_ref();
+
+	traverser(a) | [&](auto state) {
+		auto i = get_index<'i'>(state);
+		a[state] = (int)((i * 7) % 17);
+	};
+
+	const auto max = [](int x, int y) { return x > y ? x : y; };
+	REQUIRE((traverser(a) | reduce<'i', 4>(-1, -1, max, [&](auto state) { return a[state]; })) == 16);
+
+	auto empty = traverser(a) ^ slice<'i'>(0, 0);
+	REQUIRE((empty | reduce<'i', 4>(0, [&](auto state) { return a[state]; })) == 0);
+}
+
+TEST_CASE("Multi-accumulator reduction with an initial value", "[reduce]") {
+	auto a_data = make_bag(scalar<int>() ^ vector<'i'>(10));
+	auto a = a_data.get_ref();
+
+	traverser(a) | [&](auto state) { a[state] = (int)get_index<'i'>(state) + 1; };
+
+	// the initial value is folded in once, not once per accumulator
+	const auto plus = [](int x, int y) { return x + y; };
+	REQUIRE((traverser(a) | reduce<'i', 4>(5, 0, plus, [&](auto state) { return a[state]; })) == 5 + 55);
+
+	const auto times = [](long x, long y) { return x * y; };
+	REQUIRE((traverser(a) | reduce<'i', 3>(2L, 1L, times, [&](auto state) { return (long)a[state]; })) == 2L * 3628800L);
+
+	// an initial value above all the elements is the result of a maximum
+	const auto max = [](int x, int y) { return x > y ? x : y; };
+	REQUIRE((traverser(a) | reduce<'i', 4>(100, 0, max, [&](auto state) { return a[state]; })) == 100);
+	REQUIRE((traverser(a) | reduce<'i', 4>(-7, -7, max, [&](auto state) { return a[state]; })) == 10);
+}
@@ -0,0 +1,122 @@
+#include <noarr_test/macros.hpp>
+
+#include <vector>
+
+#include <noarr/traversers.hpp>
+
+#ifdef _OPENMP
+#include <noarr/structures/interop/omp.hpp>
+#endif
+
+#ifdef NOARR_TEST_TBB
+#include <noarr/structures/interop/tbb.hpp>
+#endif
+
+using namespace noarr;
+
+TEST_CASE("Skew lengths and coverage", "[skew]") {
+	auto a = scalar<int>() ^ vector<'j'>(7) ^ vector<'i'>(5);
+	auto s = a ^ skew<'i', 'j', 'w', 'p'>(2);
+
+	STATIC_REQUIRE(decltype(s)::signature::template all_accept<'w'>);
+	STATIC_REQUIRE(decltype(s)::signature::template all_accept<'p'>);
+	STATIC_REQUIRE(!decltype(s)::signature::template any_accept<'i'>);
+	STATIC_REQUIRE(!decltype(s)::signature::template any_accept<'j'>);
+
+	REQUIRE((s | get_length<'w'>()) == 2 * 4 + 7);
+	REQUIRE((s | get_length<'p'>(idx<'w'>(0))) == 1);
+	REQUIRE((s | get_length<'p'>(idx<'w'>(4))) == 3);
+	REQUIRE((s | get_length<'p'>(idx<'w'>(14))) == 1);
+
+	std::vector<int> visited(5 * 7, 0);
+	std::size_t num_waves = 0;
+
+	traverser(a) ^ skew<'i', 'j', 'w', 'p'>(2) | for_dims<'w'>([&](auto inner) {
+		const std::size_t wave = num_waves++;
+
+		inner | [&](auto state) {
+			auto [i, j] = get_indices<'i', 'j'>(state);
+			REQUIRE(2 * i + j == wave);
+			visited[i * 7 + j]++;
+		};
+	});
+
+	REQUIRE(num_waves == 15);
+	for (auto v : visited)
+		REQUIRE(v == 1);
+}
+
+TEST_CASE("Skew preserves in-place stencil dependences", "[skew]") {
+	auto a = scalar<double>() ^ vector<'j'>(9) ^ vector<'i'>(6);
+
+	auto x_data = make_bag(a);
+	auto y_data = make_bag(a);
+	auto x = x_data.get_ref();
+	auto y = y_data.get_ref();
+
+	traverser(x, y) | [=](auto state) {
+		auto [i, j] = get_indices<'i', 'j'>(state);
+		x[state] = y[state] = (double)(i * (j + 2) + 2) / 6;
+	};
+
+	const auto body = [](auto bag) {
+		return [bag](auto state) {
+			bag[state] = (bag[state - idx<'i', 'j'>(1, 1)] + bag[state - idx<'i'>(1)] + bag[state - idx<'i'>(1) + idx<'j'>(1)] +
+			              bag[state - idx<'j'>(1)] + bag[state] + bag[state + idx<'j'>(1)] +
+			              bag[state + idx<'i'>(1) - idx<'j'>(1)] + bag[state + idx<'i'>(1)] + bag[state + idx<'i', 'j'>(1, 1)]) / 9;
+		};
+	};
+
+	traverser(x) ^ symmetric_spans<'i', 'j'>(x, 1, 1) | body(x);
+	traverser(y) ^ symmetric_spans<'i', 'j'>(y, 1, 1) ^ skew<'i', 'j'>(2) | for_dims<'i'>([=](auto wave) {
+		wave | body(y);
+	});
+
+	traverser(x, y) | [=](auto state) {
+		REQUIRE(x[state] == y[state]);
+	};
+}
+
+TEST_CASE("Parallel wavefronts preserve in-place stencil dependences", "[skew]") {
+	auto a = scalar<double>() ^ vector<'j'>(57) ^ vector<'i'>(43);
+
+	auto x_data = make_bag(a);
+	auto x = x_data.get_ref();
+
+	const auto init = [](auto bag) {
+		traverser(bag) | [=](auto state) {
+			auto [i, j] = get_indices<'i', 'j'>(state);
+			bag[state] = (double)(i * (j + 2) + 2) / 6;
+		};
+	};
+
+	// each element depends on all its neighbours, the elements of a wave of the skewed traversal are independent
+	const auto body = [](auto bag) {
+		return [bag](auto state) {
+			bag[state] = (bag[state - idx<'i', 'j'>(1, 1)] + bag[state - idx<'i'>(1)] + bag[state - idx<'i'>(1) + idx<'j'>(1)] +
+			              bag[state - idx<'j'>(1)] + bag[state] + bag[state + idx<'j'>(1)] +
+			              bag[state + idx<'i'>(1) - idx<'j'>(1)] + bag[state + idx<'i'>(1)] + bag[state + idx<'i', 'j'>(1, 1)]) / 9;
+		};
+	};
+
+	init(x);
+	traverser(x) ^ symmetric_spans<'i', 'j'>(x, 1, 1) | body(x);
+
+	[[maybe_unused]] const auto check = [&](auto wavefront) {
+		auto y_data = make_bag(a);
+		auto y = y_data.get_ref();
+		init(y);
+		wavefront(traverser(y) ^ symmetric_spans<'i', 'j'>(y, 1, 1) ^ skew<'i', 'j'>(2), body(y));
+		traverser(x, y) | [=](auto state) {
+			REQUIRE(x[state] == y[state]);
+		};
+	};
+
+#ifdef _OPENMP
+	check([](auto t, auto f) { omp_for_each_wavefront<'i'>(t, f); });
+#endif
+
+#ifdef NOARR_TEST_TBB
+	check([](auto t, auto f) { tbb_for_each_wavefront<'i'>(t, f); });
+#endif
+}
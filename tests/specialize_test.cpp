@@ -0,0 +1,25 @@
+#include <noarr_test/macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("Specialization to static lengths", "[specialize]") {
+	const auto kernel = [](auto lengths) {
+		auto s = scalar<float>() ^ vectors<'j', 'i'>() ^ lengths;
+		constexpr bool static_i = !std::is_same_v<decltype(s | get_length<'i'>()), std::size_t>;
+		constexpr bool static_j = !std::is_same_v<decltype(s | get_length<'j'>()), std::size_t>;
+		return std::array<std::size_t, 3>{s | get_length<'i'>(), s | get_length<'j'>(), std::size_t(static_i) + 2 * std::size_t(static_j)};
+	};
+
+	using result = std::array<std::size_t, 3>;
+	REQUIRE(specialize<'i', 'j'>({64, 128}, candidates<64, 128>, kernel) == result{64, 128, 3});
+	REQUIRE(specialize<'i', 'j'>({64, 100}, candidates<64, 128>, kernel) == result{64, 100, 1});
+	REQUIRE(specialize<'i', 'j'>({100, 128}, candidates<64, 128>, kernel) == result{100, 128, 2});
+	REQUIRE(specialize<'i', 'j'>({7, 9}, candidates<64, 128>, kernel) == result{7, 9, 0});
+	REQUIRE(specialize<'i', 'j'>({7, 9}, candidates<>, kernel) == result{7, 9, 0});
+}
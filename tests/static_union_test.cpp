@@ -0,0 +1,55 @@
+#include <noarr_test/macros.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("Union prefers static lengths", "[static_union]") {
+	auto dynamic = scalar<float>() ^ vector<'p'>(4) ^ vector<'q'>(3);
+	auto fixed = scalar<float>() ^ vector<'p'>(lit<4>);
+
+	using sig = decltype(traverser(dynamic, fixed).top_struct())::signature;
+	STATIC_REQUIRE(std::is_same_v<sig, function_sig<'q', dynamic_arg_length, function_sig<'p', static_arg_length<4>, scalar_sig<float>>>>);
+
+	// the order of the structures does not matter
+	using sig2 = decltype(traverser(fixed, dynamic).top_struct())::signature;
+	STATIC_REQUIRE(std::is_same_v<sig2, function_sig<'q', dynamic_arg_length, function_sig<'p', static_arg_length<4>, scalar_sig<float>>>>);
+
+	auto t = traverser(dynamic, fixed);
+	STATIC_REQUIRE(std::is_same_v<decltype(t.top_struct().template length<'p'>(empty_state)), std::integral_constant<std::size_t, 4>>);
+	REQUIRE(t.top_struct().template length<'q'>(empty_state) == 3);
+
+	// a known length is preferred to an unknown one
+	auto unknown = scalar<float>() ^ vector<'q'>();
+	using sig3 = decltype(traverser(unknown, dynamic).top_struct())::signature;
+	STATIC_REQUIRE(std::is_same_v<sig3, function_sig<'p', dynamic_arg_length, function_sig<'q', dynamic_arg_length, scalar_sig<float>>>>);
+
+	// the length is taken from the structure that knows it (as in the signature), even if it is not the first one
+	auto u = traverser(unknown, dynamic);
+	REQUIRE(u.top_struct().template length<'q'>(empty_state) == 3);
+	std::size_t visited = 0;
+	u | [&](auto) { visited++; };
+	REQUIRE(visited == 12);
+
+	u.template for_each<'q'>([&](auto state) { REQUIRE(get_index<'q'>(state) < 3); });
+}
+
+TEST_CASE("Traversal of mixed static and dynamic lengths", "[static_union]") {
+	auto a_data = make_bag(scalar<int>() ^ vector<'c'>(3) ^ vector<'i'>(5));
+	auto w_data = make_bag(scalar<int>() ^ vector<'c'>(lit<3>));
+	auto a = a_data.get_ref();
+	auto w = w_data.get_ref();
+
+	traverser(w) | [&](auto state) { w[state] = int(get_index<'c'>(state)) + 1; };
+
+	std::size_t visited = 0;
+	traverser(a, w) | [&](auto state) {
+		a[state] = w[state] * int(get_index<'i'>(state));
+		visited++;
+	};
+	REQUIRE(visited == 15);
+	traverser(a) | [&](auto state) { REQUIRE(a[state] == int(get_index<'c'>(state) + 1) * int(get_index<'i'>(state))); };
+}
@@ -0,0 +1,56 @@
+#include <noarr_test/macros.hpp>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("Stencil five-point sum", "[stencil]") {
+	auto a_data = make_bag(scalar<int>() ^ vector<'j'>(7) ^ vector<'i'>(5));
+	auto b_data = make_bag(scalar<int>() ^ vector<'j'>(7) ^ vector<'i'>(5));
+	auto a = a_data.get_ref();
+	auto b = b_data.get_ref();
+
+	traverser(a) | [&](auto s) {
+		auto [i, j] = get_indices<'i', 'j'>(s);
+		a[s] = (int)(i * 10 + j * j);
+	};
+
+	constexpr auto five_point = stencil<'i', 'j'>({{0, 0}, {0, -1}, {0, 1}, {1, 0}, {-1, 0}});
+	const auto sa = five_point.bind(a);
+
+	traverser(a, b) ^ symmetric_spans<'i', 'j'>(a, 1, 1) | [&](auto s) {
+		b[s] = sa.sum(s);
+	};
+
+	traverser(a, b) ^ symmetric_spans<'i', 'j'>(a, 1, 1) | [&](auto s) {
+		REQUIRE(b[s] == a[s] + a[s - idx<'j'>(1)] + a[s + idx<'j'>(1)] + a[s + idx<'i'>(1)] + a[s - idx<'i'>(1)]);
+		REQUIRE(sa.get<3>(s) == a[s + idx<'i'>(1)]);
+	};
+}
+
+TEST_CASE("Stencil weighted sum and combine", "[stencil]") {
+	auto a_data = make_bag(scalar<double>() ^ vector<'i'>(6) ^ vector<'j'>(4) ^ vector<'k'>(3));
+	auto a = a_data.get_ref();
+
+	traverser(a) | [&](auto s) {
+		auto [i, j, k] = get_indices<'i', 'j', 'k'>(s);
+		a[s] = (double)(i * i + 3 * j + 7 * k);
+	};
+
+	constexpr auto laplace = stencil<'i'>({{-1}, {0}, {1}}, {1., -2., 1.});
+	const auto la = laplace.bind(a, idx<'j', 'k'>(0, 0));
+
+	traverser(a) ^ symmetric_span<'i'>(a, 1) | [&](auto s) {
+		// second difference of i*i is 2
+		REQUIRE(la.sum(s) == 2.);
+		REQUIRE(la.combine(s, [](auto l, auto c, auto r) { return r - l + 0 * c; }) == a[s + idx<'i'>(1)] - a[s - idx<'i'>(1)]);
+	};
+
+	// a stencil over a different pair of dimensions of the same bag
+	constexpr auto diag = stencil<'j', 'k'>({{1, 1}, {-1, -1}});
+	const auto da = diag.bind(a, idx<'i'>(0));
+
+	traverser(a) ^ symmetric_spans<'j', 'k'>(a, 1, 1) | [&](auto s) {
+		REQUIRE(da.sum(s) == a[s + idx<'j', 'k'>(1, 1)] + a[s - idx<'j', 'k'>(1, 1)]);
+	};
+}
@@ -0,0 +1,134 @@
+#include <noarr_test/macros.hpp>
+
+#include <cstdint>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("Streaming stores", "[streaming]") {
+	auto f_data = make_bag(scalar<float>() ^ vector<'j'>(37) ^ vector<'i'>(5));
+	auto d_data = make_bag(scalar<double>() ^ vector<'j'>(37) ^ vector<'i'>(5));
+	auto s_data = make_bag(scalar<std::int16_t>() ^ vector<'j'>(37) ^ vector<'i'>(5));
+
+	auto f = streaming(f_data);
+	auto d = streaming(d_data);
+	auto s = streaming(s_data);
+
+	traverser(f, d, s) | streamed([=](auto state) {
+		auto [i, j] = get_indices<'i', 'j'>(state);
+		f[state] = float(i * 100 + j) / 4;
+		d[state] = double(i * 100 + j) / 8;
+		s[state] = std::int16_t(i * 100 + j);
+	});
+
+	traverser(f_data) | [&](auto state) {
+		auto [i, j] = get_indices<'i', 'j'>(state);
+		REQUIRE(f_data[state] == float(i * 100 + j) / 4);
+		REQUIRE(d_data[state] == double(i * 100 + j) / 8);
+		REQUIRE(s_data[state] == std::int16_t(i * 100 + j));
+	};
+}
+
+TEST_CASE("Streaming stores in nested traversals", "[streaming]") {
+	auto data = make_bag(scalar<int>() ^ vector<'j'>(10) ^ vector<'i'>(4));
+	auto out = streaming(data);
+
+	traverser(out) | streamed(for_dims<'i'>([=](auto inner) {
+		int acc = 0;
+		inner | [=, &acc](auto state) {
+			acc += int(get_index<'j'>(state));
+			out[state] = acc;
+		};
+	}));
+
+	traverser(data) | [&](auto state) {
+		const int j = int(get_index<'j'>(state));
+		REQUIRE(data[state] == j * (j + 1) / 2);
+	};
+}
+
+TEST_CASE("Streaming stores into a part of the bag", "[streaming]") {
+	auto data = make_bag(scalar<double>() ^ vector<'j'>(101) ^ vector<'i'>(7));
+	auto out = streaming(data);
+
+	traverser(data) | [&](auto state) { data[state] = -1; };
+
+	// an unaligned part of the rows, every other element of the sliced rows (the others are not overwritten)
+	traverser(out) ^ slice<'j'>(3, 95) ^ step<'i'>(0, 2) | streamed([=](auto state) {
+		auto [i, j] = get_indices<'i', 'j'>(state);
+		out[state] = double(i * 1000 + j);
+	});
+
+	traverser(data) | [&](auto state) {
+		auto [i, j] = get_indices<'i', 'j'>(state);
+		const bool written = i % 2 == 0 && j >= 3 && j < 98;
+		REQUIRE(data[state] == (written ? double(i * 1000 + j) : -1));
+	};
+}
+
+TEST_CASE("Streaming stores of bytes", "[streaming]") {
+	auto data = make_bag(scalar<std::uint8_t>() ^ vector<'j'>(203));
+	auto out = streaming(data);
+
+	traverser(data) | [&](auto state) { data[state] = 7; };
+
+	traverser(out) ^ step<'j'>(1, 3) | streamed([=](auto state) {
+		out[state] = std::uint8_t(get_index<'j'>(state) % 251);
+	});
+
+	traverser(data) | [&](auto state) {
+		const auto j = get_index<'j'>(state);
+		REQUIRE(data[state] == (j % 3 == 1 ? std::uint8_t(j % 251) : 7));
+	};
+}
+
+TEST_CASE("Streaming the values of a traversal", "[streaming]") {
+	auto a_data = make_bag(scalar<double>() ^ vector<'j'>(203) ^ vector<'i'>(5));
+	auto out_data = make_bag(scalar<double>() ^ vector<'j'>(203) ^ vector<'i'>(5));
+	auto a = a_data.get_ref();
+	auto out = out_data.get_ref();
+
+	traverser(a) | [=](auto state) {
+		auto [i, j] = get_indices<'i', 'j'>(state);
+		a[state] = double(i * 1000 + j);
+	};
+
+	// contiguous runs (with unaligned ends)
+	traverser(a, out) ^ slice<'j'>(1, 200) | stream_into(out, [=](auto state) { return 2 * a[state]; });
+	traverser(out) | [=](auto state) {
+		const auto j = get_index<'j'>(state);
+		if (j >= 1 && j < 201)
+			REQUIRE(out[state] == 2 * a[state]);
+	};
+
+	// a reversed run and a transposed traversal are stored element by element
+	traverser(a, out) ^ reverse<'j'>() | stream_into(out, [=](auto state) { return a[state] + 1; });
+	traverser(out) | [=](auto state) { REQUIRE(out[state] == a[state] + 1); };
+
+	traverser(a, out) ^ hoist<'j'>() | stream_into(out, [=](auto state) { return a[state] - 1; });
+	traverser(out) | [=](auto state) { REQUIRE(out[state] == a[state] - 1); };
+
+	// float elements, a single dimension
+	auto f_data = make_bag(scalar<float>() ^ vector<'k'>(1001));
+	traverser(f_data) | stream_into(f_data, [](auto state) { return float(get_index<'k'>(state)) / 2; });
+	traverser(f_data) | [&](auto state) { REQUIRE(f_data[state] == float(get_index<'k'>(state)) / 2); };
+}
+
+TEST_CASE("Streaming stores in an explicit scope", "[streaming]") {
+	auto data = make_bag(scalar<double>() ^ vector<'j'>(64));
+	auto out = streaming(data);
+
+	REQUIRE(!stream_scope::active());
+	{
+		const stream_scope scope;
+		traverser(out) | [=](auto state) { out[state] = double(get_index<'j'>(state)) * 3; };
+
+		// the nested scopes do not fence, only the outermost one does
+		traverser(out) | streamed([=](auto state) { out[state] = double(get_index<'j'>(state)) * 2; });
+		REQUIRE(stream_scope::active());
+	}
+	REQUIRE(!stream_scope::active());
+
+	traverser(data) | [&](auto state) { REQUIRE(data[state] == double(get_index<'j'>(state)) * 2); };
+}
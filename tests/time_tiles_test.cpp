@@ -0,0 +1,123 @@
+#include <noarr_test/macros.hpp>
+
+#include <vector>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("Time tiles coverage", "[time_tiles]") {
+	auto a = scalar<int>() ^ vector<'i'>(13) ^ bcast<'t'>(7);
+	auto tiled = a ^ time_tiles<'t', 'i', 'T', 'I'>(3, 4, 2);
+
+	REQUIRE((tiled | get_length<'T'>()) == 3);
+	REQUIRE((tiled | get_length<'I'>()) == (12 + 6 * 2) / 4 + 1);
+	REQUIRE((tiled | get_length<'t'>(idx<'T'>(2))) == 1);
+	REQUIRE((tiled | get_length<'i'>(idx<'T', 'I', 't'>(0, 0, 0))) == 4);
+	REQUIRE((tiled | get_length<'i'>(idx<'T', 'I', 't'>(0, 0, 1))) == 2);
+	REQUIRE((tiled | get_length<'i'>(idx<'T', 'I', 't'>(0, 3, 0))) == 1);
+
+	std::vector<int> visited(7 * 13, 0);
+	std::size_t last_t = 0;
+
+	traverser(a) ^ time_tiles<'t', 'i', 'T', 'I'>(3, 4, 2) | for_dims<'T', 'I', 't'>([&](auto inner) {
+		inner | [&](auto state) {
+			auto [t, i] = get_indices<'t', 'i'>(state);
+			visited[t * 13 + i]++;
+			last_t = t;
+		};
+	});
+
+	REQUIRE(last_t == 6);
+	for (auto v : visited)
+		REQUIRE(v == 1);
+}
+
+TEST_CASE("Time tiles expose the global time step", "[time_tiles]") {
+	auto steps = scalar<char>() ^ bcast<'t'>(8);
+	auto a = scalar<int>() ^ vector<'i'>(10);
+
+	// the state of a traverser maps the index of the step within the tile back to the global step
+	std::size_t tile = 0, count = 0;
+	traverser(a, steps) ^ time_tiles<'t', 'i', 'T', 'I'>(3, 4) | for_dims<'T'>([&](auto time_tile) {
+		time_tile | for_dims<'I'>([&](auto space_tile) {
+			std::size_t t = 0;
+			space_tile | for_dims<'t'>([&](auto inner) {
+				REQUIRE(get_index<'t'>(inner) == tile * 3 + t);
+				t++;
+				count++;
+			});
+		});
+		tile++;
+	});
+	REQUIRE(tile == 3);
+	REQUIRE(count > 0);
+}
+
+TEST_CASE("Time tiles preserve stencil dependences", "[time_tiles]") {
+	constexpr std::size_t n = 40;
+	constexpr std::size_t tsteps = 9;
+
+	auto vec = scalar<double>() ^ vector<'i'>(n);
+
+	auto x_a_data = make_bag(vec), x_b_data = make_bag(vec);
+	auto y_a_data = make_bag(vec), y_b_data = make_bag(vec);
+	auto z_a_data = make_bag(vec), z_b_data = make_bag(vec);
+	auto x_a = x_a_data.get_ref(), x_b = x_b_data.get_ref();
+	auto y_a = y_a_data.get_ref(), y_b = y_b_data.get_ref();
+	auto z_a = z_a_data.get_ref(), z_b = z_b_data.get_ref();
+
+	traverser(x_a) | [=](auto state) {
+		auto i = get_index<'i'>(state);
+		x_a[state] = y_a[state] = z_a[state] = (double)(i * i % 7) / 3;
+		x_b[state] = y_b[state] = z_b[state] = (double)(i % 5) / 2;
+	};
+
+	// each time step is split into two half steps (B from A and A from B), each depends on the distance 1 in 'i'
+	const auto half_step = [](auto a, auto b) {
+		return [=](auto inner) {
+			const auto sweep = [](auto to, auto from) {
+				return [=](auto state) {
+					to[state] = (from[state - idx<'i'>(1)] + from[state] + from[state + idx<'i'>(1)]) / 3;
+				};
+			};
+
+			if (get_index<'t'>(inner) % 2 == 0)
+				inner | sweep(b, a);
+			else
+				inner | sweep(a, b);
+		};
+	};
+
+	// a structure that makes the time step index visible in the traversal state
+	auto steps = scalar<char>() ^ bcast<'t'>(2 * tsteps);
+
+	traverser(x_a, x_b, steps) ^ symmetric_span<'i'>(x_a, 1) | for_dims<'t'>(half_step(x_a, x_b));
+
+	traverser(y_a, y_b, steps) ^ symmetric_span<'i'>(y_a, 1) ^ time_tiles<'t', 'i', 'T', 'I'>(4, 5, 1) |
+		for_dims<'T', 'I', 't'>(half_step(y_a, y_b));
+
+	// an odd number of steps in a tile: the tiles alternate in the parity of their first (global) step
+	auto w_a_data = make_bag(vec), w_b_data = make_bag(vec);
+	auto w_a = w_a_data.get_ref(), w_b = w_b_data.get_ref();
+	traverser(w_a) | [=](auto state) {
+		auto i = get_index<'i'>(state);
+		w_a[state] = (double)(i * i % 7) / 3;
+		w_b[state] = (double)(i % 5) / 2;
+	};
+	traverser(w_a, w_b, steps) ^ symmetric_span<'i'>(w_a, 1) ^ time_tiles<'t', 'i', 'T', 'I'>(3, 5, 1) |
+		for_dims<'T', 'I', 't'>(half_step(w_a, w_b));
+
+	// the tiles on an anti-diagonal are independent, traverse them in the reverse order
+	traverser(z_a, z_b, steps) ^ symmetric_span<'i'>(z_a, 1) ^ time_tiles<'t', 'i', 'T', 'I'>(4, 5, 1) ^
+		skew<'T', 'I', 'W', 'P'>(1) ^ reverse<'P'>() | for_dims<'W', 'P', 't'>(half_step(z_a, z_b));
+
+	traverser(x_a) | [=](auto state) {
+		REQUIRE(x_a[state] == y_a[state]);
+		REQUIRE(x_b[state] == y_b[state]);
+		REQUIRE(x_a[state] == z_a[state]);
+		REQUIRE(x_b[state] == z_b[state]);
+		REQUIRE(x_a[state] == w_a[state]);
+		REQUIRE(x_b[state] == w_b[state]);
+	};
+}
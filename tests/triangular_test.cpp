@@ -0,0 +1,114 @@
+#include <noarr_test/macros.hpp>
+
+#include <vector>
+
+#include <noarr/traversers.hpp>
+
+#ifdef _OPENMP
+#include <noarr/structures/interop/omp.hpp>
+#endif
+
+#ifdef NOARR_TEST_TBB
+#include <noarr/structures/interop/tbb.hpp>
+#endif
+
+using namespace noarr;
+
+TEST_CASE("Triangular iteration spaces", "[triangular]") {
+	auto a = scalar<int>() ^ vector<'j'>(9) ^ vector<'i'>(12);
+
+	std::vector<int> lower(12 * 9, 0), upper(12 * 9, 0);
+	std::size_t lower_count = 0, upper_count = 0;
+
+	lower_triangle<'i', 'j'>().for_each(traverser(a), [&](auto state) {
+		auto [i, j] = get_indices<'i', 'j'>(state);
+		lower[i * 9 + j]++;
+		lower_count++;
+	});
+
+	upper_triangle<'i', 'j'>(2).for_each(traverser(a), [&](auto state) {
+		auto [i, j] = get_indices<'i', 'j'>(state);
+		upper[i * 9 + j]++;
+		upper_count++;
+	});
+
+	for (std::size_t i = 0; i < 12; i++) {
+		for (std::size_t j = 0; j < 9; j++) {
+			REQUIRE(lower[i * 9 + j] == (j <= i));
+			REQUIRE(upper[i * 9 + j] == (j >= i + 2));
+		}
+	}
+
+	// the work also counts one unit per row
+	REQUIRE(lower_triangle<'i', 'j'>().range(traverser(a)).work() == lower_count + 12);
+	REQUIRE(upper_triangle<'i', 'j'>(2).range(traverser(a)).work() == upper_count + 12);
+}
+
+TEST_CASE("Triangular range splits by work", "[triangular]") {
+	auto a = scalar<int>() ^ vector<'j'>(1000) ^ vector<'i'>(1000);
+
+	struct split {};
+
+	auto left = lower_triangle<'i', 'j'>().range(traverser(a));
+	auto right = decltype(left)(left, split());
+
+	REQUIRE(left.begin_idx == 0);
+	REQUIRE(left.end_idx == right.begin_idx);
+	REQUIRE(right.end_idx == 1000);
+
+	// the halves of a lower triangle: the first one has more rows, but the same work
+	REQUIRE(left.size() > right.size());
+	REQUIRE(left.work() <= right.work() + 1000);
+	REQUIRE(right.work() <= left.work() + 1000);
+
+	auto up_left = upper_triangle<'i', 'j'>().range(traverser(a));
+	auto up_right = decltype(up_left)(up_left, split());
+
+	REQUIRE(up_left.size() < up_right.size());
+	REQUIRE(up_left.work() <= up_right.work() + 1000);
+	REQUIRE(up_right.work() <= up_left.work() + 1000);
+
+	std::size_t rows = 0;
+	up_right.for_sections([&](auto inner) {
+		auto i = up_right.begin_idx + rows++;
+		REQUIRE((inner.top_struct() | get_length<'j'>()) == 1000 - i);
+	});
+	REQUIRE(rows == up_right.size());
+}
+
+TEST_CASE("Parallel triangular traversals", "[triangular]") {
+	auto a = scalar<int>() ^ vector<'j'>(50) ^ vector<'i'>(60);
+
+	// each executor traverses a lower and an upper triangle with offsets (the rows are disjoint, so the counts do not race)
+	[[maybe_unused]] const auto check = [&](auto executor) {
+		std::vector<int> lower(60 * 50, 0), upper(60 * 50, 0);
+
+		executor(traverser(a), lower_triangle<'i', 'j'>(3), [&](auto state) {
+			auto [i, j] = get_indices<'i', 'j'>(state);
+			lower[i * 50 + j]++;
+		});
+		executor(traverser(a), upper_triangle<'i', 'j'>(2), [&](auto state) {
+			auto [i, j] = get_indices<'i', 'j'>(state);
+			upper[i * 50 + j]++;
+		});
+
+		for (std::size_t i = 0; i < 60; i++) {
+			for (std::size_t j = 0; j < 50; j++) {
+				REQUIRE(lower[i * 50 + j] == (j < i + 3));
+				REQUIRE(upper[i * 50 + j] == (j >= i + 2));
+			}
+		}
+	};
+
+#ifdef _OPENMP
+	check([](auto t, auto triangle, auto f) { omp_for_each(t, triangle, f); });
+	check([](auto t, auto triangle, auto f) { omp_for_each(t, triangle, f, 4); });
+#endif
+
+#ifdef NOARR_TEST_TBB
+	check([](auto t, auto triangle, auto f) { tbb_for_each(t, triangle, f); });
+	check([](auto t, auto triangle, auto f) {
+		tbb_for_sections(t, triangle, [&f](auto row) { row | f; });
+	});
+#endif
+}
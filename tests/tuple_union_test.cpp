@@ -0,0 +1,60 @@
+#include <noarr_test/macros.hpp>
+
+#include <type_traits>
+
+#include <noarr/traversers.hpp>
+
+using namespace noarr;
+
+TEST_CASE("Union of a tuple with a plain structure", "[tuple_union]") {
+	auto fields = pack(scalar<float>() ^ vector<'i'>(5), scalar<int>() ^ vector<'i'>(5)) ^ tuple<'f'>();
+	auto weights = scalar<float>() ^ vector<'i'>(5);
+
+	using sig = decltype(traverser(fields, weights).top_struct())::signature;
+	STATIC_REQUIRE(sig::dependent);
+	STATIC_REQUIRE(sig::ret_sig<0>::template all_accept<'i'>);
+
+	auto fields_data = make_bag(fields);
+	auto weights_data = make_bag(weights);
+	auto f = fields_data.get_ref();
+	auto w = weights_data.get_ref();
+
+	traverser(w) | [&](auto state) { w[state] = float(get_index<'i'>(state)); };
+
+	std::size_t visited = 0;
+	traverser(f, w) | [&](auto state) {
+		f[state] = 2 * w[state] + get_index<'f'>(state);
+		visited++;
+	};
+	REQUIRE(visited == 10);
+
+	traverser(w) | [&](auto state) {
+		const auto i = get_index<'i'>(state);
+		REQUIRE(f[state.template with<index_in<'f'>>(lit<0>)] == float(2 * i));
+		REQUIRE(f[state.template with<index_in<'f'>>(lit<1>)] == int(2 * i + 1));
+	};
+}
+
+TEST_CASE("Union of tuples (struct of arrays and array of structs)", "[tuple_union]") {
+	auto soa = pack(scalar<float>() ^ vectors<'j', 'i'>(4, 3), scalar<float>() ^ vectors<'j', 'i'>(4, 3)) ^ tuple<'f'>();
+	auto aos = pack(scalar<float>(), scalar<float>()) ^ tuple<'f'>() ^ vectors<'j', 'i'>(4, 3);
+
+	auto src_data = make_bag(soa);
+	auto dst_data = make_bag(aos);
+	auto src = src_data.get_ref();
+	auto dst = dst_data.get_ref();
+
+	traverser(src) | [&](auto state) {
+		auto [i, j] = get_indices<'i', 'j'>(state);
+		src[state] = float(i * 10 + j + 100 * get_index<'f'>(state));
+	};
+
+	std::size_t visited = 0;
+	traverser(dst, src) | [&](auto state) {
+		dst[state] = src[state];
+		visited++;
+	};
+	REQUIRE(visited == 2 * 3 * 4);
+
+	traverser(src) | [&](auto state) { REQUIRE(dst[state] == src[state]); };
+}